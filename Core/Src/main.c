@@ -67,7 +67,8 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-float target_speed; // 定义目标速度
+float target_speed;    // 定义目标速度
+float target_position; // 定义目标位置（串级模式，单位度）
 uint8_t READ_SPEED = 0;
 uint8_t MPU_READ   = 0;
 int up_menu        = 0;
@@ -200,6 +201,8 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
             MPU6050_Read_All(&mpu6050Data);
         }
     }
+    // 编码器定时器回绕和PWM定时器周期边界，分派给对应的电机
+    encoder_motor_timer_update(htim);
     if (htim == &htim2)
     {
         if (READ_SPEED == 1)
@@ -208,7 +211,7 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
         }
         else
         {
-            Update_Motor_Speed(target_speed);
+            Update_Motor_Control(target_speed, target_position);
         }
     }
 }
@@ -1,21 +1,118 @@
 #ifndef __ENCODER_H
 #define __ENCODER_H
 
+#include "biquad.h"
+#include "encoder_motor.h"
 #include "gpio.h"
+#include "loop_timer.h"
 #include "main.h"
+#include "motor_health.h"
+#include "motor_reversal.h"
+#include "mt_speed.h"
 #include "pid.h"
+#include "pid_autotune.h"
+#include "pid_cascade.h"
+#include "pid_metrics.h"
+#include "pid_rls.h"
+#include "pid_schedule.h"
+#include "pid_step_test.h"
+#include "pid_velocity.h"
+#include "speed_observer.h"
 #include "tim.h"
+#include "traj.h"
 #include <math.h>
 
-// 编码器分辨率（每转一圈的脉冲数）
-#define PULSES_PER_REVOLUTION 11.0f
-// 分频系数
-#define FREQUENCY_DOUBLING_COEFFICIENT 4
-// 减速比
-#define REDUCTION_RATIO 4.4
+// 编码器分辨率、倍频系数、减速比和计数 -> 角度换算见 encoder_speed.h（不依赖 HAL，主机测试共用）
 // 满转速（单位为转/秒，可根据实际需求调整）
 #define FULL_SPEED_RPM 1300.0f // 假设满转速为 1000 rps
 
+// TIM2 控制中断的默认周期（秒），运行中可用 Motor_Set_Control_Rate 修改，实际周期由 DWT 测得
+#define MOTOR_CONTROL_PERIOD 0.1f
+// Motor_Set_Control_Rate 允许的控制频率范围（Hz）
+#define MOTOR_CONTROL_RATE_MIN 100.0f
+#define MOTOR_CONTROL_RATE_MAX 10000.0f
+
+// 串级控制：外环（位置环）和内环（速度环）相对 TIM2 节拍的分频
+#define POSITION_LOOP_DIVIDER 2
+#define SPEED_LOOP_DIVIDER 1
+// 位置环默认参数：输入为角度（度），输出为速度设定值
+#define POSITION_KP 1.0f
+#define POSITION_KI 0.0f
+#define POSITION_KD 0.0f
+
+// 速度环静态前馈：Encoder_Motor_SetSpeed 的 speed 满量程 FULL_SPEED_RPM 对应 100% 占空比，
+// 理想情况下目标转速即为所需控制量，另加克服静摩擦的固定偏置
+#define FEEDFORWARD_GAIN 1.0f                                // 前馈控制量 / 目标转速
+#define FEEDFORWARD_STATIC_FRICTION (0.05f * FULL_SPEED_RPM) // 静摩擦补偿
+#define FEEDFORWARD_DEADBAND 1.0f                            // 目标转速低于此值时不加前馈
+// 换向状态机：控制量过零时先制动/滑行再反向，控制量单位同 Encoder_Motor_SetSpeed 的 speed，
+// 等待时间按控制周期向上取整，至少一拍
+#define MOTOR_REVERSAL_DWELL 0.002f                        // 换向前制动/滑行的时间（秒）
+#define MOTOR_REVERSAL_DWELL_MODE 2                        // 换向等待和停止时的模式：2 制动，3 滑行
+#define MOTOR_REVERSAL_HYSTERESIS (0.01f * FULL_SPEED_RPM) // 过零滞环，反向控制量超过此值才换向
+// 死区补偿（静摩擦偏置）：速度环前馈已含 FEEDFORWARD_STATIC_FRICTION，默认不再叠加，
+// 串级、增量式等不带前馈的模式可按电机实测设置
+#define MOTOR_DEADBAND_COMPENSATION 0.0f
+// 健康监测：检出故障后以 Encoder_Motor_SetSpeed(3, 0) 切断输出并锁存故障码，
+// 时间按控制周期向上取整为节拍数
+#define MOTOR_HEALTH_STALL_OUTPUT (0.8f * FULL_SPEED_RPM)     // 堵转：|控制量| 不低于此值
+#define MOTOR_HEALTH_STALL_SPEED (0.02f * FULL_SPEED_RPM)     // 堵转：窗口内平均速度低于此值
+#define MOTOR_HEALTH_STALL_TIME 0.5f                          // 堵转窗口（秒）
+#define MOTOR_HEALTH_RUNAWAY_RATIO 1.5f                       // 飞车：|速度| 超过 |指令| 的倍数
+#define MOTOR_HEALTH_RUNAWAY_MARGIN (0.2f * FULL_SPEED_RPM)   // 飞车：判据的绝对裕量
+#define MOTOR_HEALTH_RUNAWAY_TIME 0.3f                        // 飞车持续时间（秒）
+#define MOTOR_HEALTH_DIRECTION_OUTPUT (0.3f * FULL_SPEED_RPM) // 方向不符：|控制量| 不低于此值
+#define MOTOR_HEALTH_DIRECTION_SPEED (0.1f * FULL_SPEED_RPM)  // 方向不符：反向速度超过此值
+#define MOTOR_HEALTH_DIRECTION_TIME 1.0f                      // 方向不符持续时间（秒），含换向减速
+#define MOTOR_HEALTH_GLITCH_RATIO 3.0f                        // 计数跳变：单拍计数超过满速时的倍数
+
+// 速度环二自由度设定值权重
+#define SPEED_SETPOINT_WEIGHT_B 0.5f // 比例项
+#define SPEED_SETPOINT_WEIGHT_C 0.0f // 微分项
+
+// S 曲线轨迹限幅：速度轨迹单位为转/分，位置轨迹单位为度
+#define TRAJ_SPEED_MAX_ACC FULL_SPEED_RPM                     // 速度轨迹最大加速度（1秒升到满速）
+#define TRAJ_SPEED_MAX_JERK (4.0f * FULL_SPEED_RPM)           // 速度轨迹最大加加速度
+#define TRAJ_POSITION_MAX_VEL (1.5f * FULL_SPEED_RPM)         // 位置轨迹最大速度（度/秒）
+#define TRAJ_POSITION_MAX_ACC (2.0f * TRAJ_POSITION_MAX_VEL)  // 位置轨迹最大加速度
+#define TRAJ_POSITION_MAX_JERK (4.0f * TRAJ_POSITION_MAX_ACC) // 位置轨迹最大加加速度
+
+// 级联二阶节滤波：测速信号在PID之前、PID输出在PWM之前各经过一条滤波链，频率为0时不启用该节
+#define SPEED_FILTER_NOTCH_HZ 0.0f     // 测速陷波中心频率（Hz），用于滤除齿轮箱共振
+#define SPEED_FILTER_NOTCH_Q 2.0f      // 测速陷波品质因数
+#define OUTPUT_FILTER_LOWPASS_HZ 0.0f  // 输出低通截止频率（Hz）
+#define OUTPUT_FILTER_LOWPASS_Q 0.707f // 输出低通品质因数
+
+// 测速观测器参数（OBSERVER_* / KALMAN_*）见 encoder_speed.h，与一阶低通测速一起在主机上对比
+
+// M/T 法测速：TIM3 CH1 捕获编码器 A 相上升沿，中断中用 DWT 周期计数器打时间戳
+#define MT_COUNTS_PER_EDGE FREQUENCY_DOUBLING_COEFFICIENT // 相邻两次捕获之间的计数（A相一个周期）
+#define MT_SWITCH_HIGH_EDGE_RATE 2000.0f // 捕获中断频率（次/秒）高于此值时切到 M 法并关闭捕获中断
+#define MT_SWITCH_LOW_EDGE_RATE 1500.0f  // 低于此值时切回 T 法
+
+// 在线辨识（RLS）：速度环每拍用归一化的控制量和转速拟合一阶模型
+#define RLS_FORGETTING_FACTOR 0.99f   // 遗忘因子
+#define RLS_INITIAL_COVARIANCE 100.0f // 协方差初值
+#define RLS_MIN_CONFIDENCE 0.8f       // 置信度低于此值时不按模型重整定
+#define RLS_DAMPING 1.0f              // 极点配置的闭环阻尼比 ζ
+#define RLS_BANDWIDTH_RATIO 2.0f      // 闭环自然频率 ω 与开环带宽 1/τ 之比
+#define RLS_RETUNE_PERIOD 5.0f        // 重整定间隔（秒）
+
+// 控制性能统计：调节时间的误差带（阶跃幅值的比例）
+#define METRICS_SETTLING_BAND 0.05f
+
+// 继电反馈自整定参数
+#define AUTOTUNE_RELAY_AMPLITUDE (0.2f * FULL_SPEED_RPM) // 继电输出幅值
+#define AUTOTUNE_HYSTERESIS 10.0f                        // 继电切换滞环（与速度同单位）
+#define AUTOTUNE_CYCLES 4                                // 参与平均的振荡周期数
+#define AUTOTUNE_TIMEOUT 60.0f                           // 超时（秒）
+
+// 开环阶跃测试参数（控制量单位同Encoder_Motor_SetSpeed的speed）
+#define STEP_TEST_INITIAL_OUTPUT (0.1f * FULL_SPEED_RPM) // 阶跃前的控制量（越过静摩擦）
+#define STEP_TEST_DEFAULT_OUTPUT (0.5f * FULL_SPEED_RPM) // 未指定时阶跃后的控制量
+#define STEP_TEST_BASELINE_TIME 3.0f                     // 阶跃前等待稳定的时间（秒）
+#define STEP_TEST_RECORD_TIME 24.0f                      // 阶跃后记录响应的时长（秒）
+
 #define SPEED_UNIT_IS_RPM
 
 #ifndef SPEED_UNIT_IS_RPM
@@ -31,6 +128,9 @@
 #define SPEED_TO_RPM(x) (x)
 #endif
 
+// 速度 = 计数/秒 × COUNTS_TO_SPEED（单位由 SPEED_TO_RPM 决定），编译期由编码器参数算出
+#define COUNTS_TO_SPEED ((float)(SPEED_TO_RPM(1.0) / COUNTS_PER_OUTPUT_REVOLUTION))
+
 #define Encoder_Motor_AIN1(x)                                                                      \
     ((x == 1) ? (ENCODER_AIN1_GPIO_Port->BSRR = ENCODER_AIN1_Pin)                                  \
               : (ENCODER_AIN1_GPIO_Port->BRR = ENCODER_AIN1_Pin))
@@ -38,14 +138,89 @@
     ((x == 1) ? (ENCODER_AIN2_GPIO_Port->BSRR = ENCODER_AIN2_Pin)                                  \
               : (ENCODER_AIN2_GPIO_Port->BRR = ENCODER_AIN2_Pin))
 
+// 电机控制模式
+typedef enum
+{
+    MOTOR_MODE_SPEED = 0,   // 速度闭环
+    MOTOR_MODE_CASCADE,     // 位置 -> 速度串级闭环
+    MOTOR_MODE_AUTOTUNE,    // 继电反馈自整定
+    MOTOR_MODE_SCHEDULED,   // 按转速增益调度的速度闭环
+    MOTOR_MODE_INCREMENTAL, // 增量式PID速度闭环（手动/自动无扰切换）
+    MOTOR_MODE_STEP_TEST,   // 开环阶跃测试与FOPDT拟合整定
+    MOTOR_MODE_COUNT
+} MotorControlMode;
+
+// 测速估计器
+typedef enum
+{
+    MOTOR_ESTIMATOR_EMA = 0,    // 计数差 + 一阶低通（定点，SPEED_EMA_COEFFICIENT）
+    MOTOR_ESTIMATOR_ALPHA_BETA, // α-β观测器
+    MOTOR_ESTIMATOR_KALMAN,     // 二状态稳态卡尔曼观测器
+    MOTOR_ESTIMATOR_MT,         // M/T 法（低速用边沿时间戳，高速用计数差，自动切换）
+    MOTOR_ESTIMATOR_COUNT
+} MotorSpeedEstimator;
+
 extern float motor_speed_rps;
 extern PIDController pid;
+extern PIDController pid_position;
+extern PIDCascade pid_cascade;
+extern PIDAutotune pid_autotune;
+extern PIDStepTest motor_step_test;
+extern PIDGainSchedule motor_gain_schedule;
+extern PIDVelocity pid_incremental;
+extern float motor_output;
+extern uint8_t motor_feedforward_enabled;
+extern EncoderMotor motor_main;
+extern MotorReversal motor_reversal;
+extern MotorHealth motor_health;
+extern MotorControlMode motor_control_mode;
+extern MotorSpeedEstimator motor_speed_estimator;
+extern SpeedObserver motor_observer;
+extern MTSpeed motor_mt_speed;
+extern Trajectory motor_trajectory;
+extern LoopTimer motor_loop_timer;
+extern PIDMetrics motor_metrics;
+extern BiquadChain motor_speed_filter;
+extern BiquadChainQ31 motor_speed_filter_q31;
+extern BiquadChain motor_output_filter;
+extern PIDRls motor_rls;
+extern uint8_t motor_rls_retune_enabled;
+extern uint8_t motor_measured_dt_enabled;
+extern float motor_control_period;
+extern uint8_t motor_pwm_sync_enabled;
+extern uint8_t motor_trajectory_enabled;
 
 
 void Encoder_Motor_Init();
+void Motor_Filter_Init(float fs);
+void Motor_Speed_Filter_Sync();
+float Motor_Set_Control_Rate(float frequency);
+float Motor_Control_Rate();
+float Motor_Control_Load();
+void Motor_Set_Speed_Estimator(MotorSpeedEstimator estimator);
 void Encoder_Motor_SetSpeed(uint8_t mode, uint16_t speed);
 void Motor_Speed();
+float Motor_Speed_Feedforward(float target_speed);
 void Update_Motor_Speed(float setpoint);
+void Update_Motor_Speed_Scheduled(float setpoint);
+void Update_Motor_Speed_Incremental(float setpoint);
+void Update_Motor_Position(float target_position);
+int64_t Motor_Encoder_Read();
+void Motor_Position_Zero();
+int64_t Motor_Position_Counts();
+float Motor_Position_Degrees();
+float Motor_Velocity();
+MotorFault Motor_Fault();
+void Motor_Health_Clear();
+void Motor_Autotune_Start(float setpoint, float Ts);
+void Update_Motor_Autotune();
+uint8_t Motor_Autotune_Apply(PIDTuneRule rule);
+void Motor_Step_Test_Start(float output, float Ts);
+void Update_Motor_Step_Test();
+uint8_t Motor_Step_Test_Apply(PIDFopdtRule rule);
+void Motor_Trajectory_Start(float Ts);
+void Motor_Metrics_Start(float setpoint, float Ts);
+void Update_Motor_Control(float target_speed, float target_position);
 void motor_positive();
 void motor_reverse();
 
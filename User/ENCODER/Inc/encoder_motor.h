@@ -0,0 +1,88 @@
+#ifndef __ENCODER_MOTOR_H
+#define __ENCODER_MOTOR_H
+
+#include "encoder_speed.h"
+#include "main.h"
+#include "pid.h"
+#include "tim.h"
+
+// 可同时驱动的编码器电机数
+#define ENCODER_MOTOR_MAX 2
+
+// 编码器电机实例：一路 PWM + 两个方向引脚 + 一个编码器模式定时器
+typedef struct
+{
+    // 硬件绑定
+    TIM_HandleTypeDef* pwm_timer;     // PWM 定时器，占空比满量程为 ARR + 1
+    uint32_t pwm_channel;             // PWM 通道
+    TIM_HandleTypeDef* encoder_timer; // 编码器模式定时器（16 位，自由运行）
+    GPIO_TypeDef* ain1_port;          // 方向引脚 AIN1 端口
+    uint16_t ain1_pin;                // 方向引脚 AIN1
+    GPIO_TypeDef* ain2_port;          // 方向引脚 AIN2 端口
+    uint16_t ain2_pin;                // 方向引脚 AIN2
+    // 同步输出：比较值预装载，方向切换推迟到 PWM 周期边界
+    uint8_t synchronized;     // 1：同步输出（比较值须开启预装载），0：立即写入
+    uint8_t ain1_state;       // 方向引脚 AIN1 当前电平
+    uint8_t ain2_state;       // 方向引脚 AIN2 当前电平
+    volatile uint8_t pending; // 是否有待 PWM 更新中断完成的方向切换
+    uint8_t pending_ain1;     // 待切换的 AIN1 电平
+    uint8_t pending_ain2;     // 待切换的 AIN2 电平
+    uint32_t pending_compare; // 方向切换后写入的比较值
+    // 换算常数
+    float full_speed; // 100% 占空比对应的控制量（同 Encoder_Motor_SetSpeed 的 speed）
+    // 64 位扩展位置 = base + wraps * 2^16 + 计数器值
+    volatile int32_t wraps; // 计数器回绕次数，由更新中断维护
+    int64_t base;           // 重新初始化编码器定时器之前的位置
+    int64_t last;           // 上一次采样时的扩展位置
+    int64_t offset;         // 位置零点
+    int64_t position;       // 上一次采样时相对零点的位置（计数）
+    // 测速（周期计数器为 DWT）
+    EncoderSpeed meter;
+    // 控制
+    PIDController* pid; // 速度环，为 NULL 时 encoder_motor_update 只测速
+    float setpoint;     // 速度设定值
+    float output;       // 最近一次输出的带符号控制量
+} EncoderMotor;
+
+// 绑定硬件并清零状态（不操作硬件）
+void encoder_motor_init(EncoderMotor* motor, TIM_HandleTypeDef* pwm_timer, uint32_t pwm_channel,
+                        TIM_HandleTypeDef* encoder_timer, GPIO_TypeDef* ain1_port,
+                        uint16_t ain1_pin, GPIO_TypeDef* ain2_port, uint16_t ain2_pin,
+                        float full_speed, float counts_to_speed);
+// 启动 PWM 和编码器，使能编码器定时器的更新中断，需在定时器初始化之后调用
+void encoder_motor_start(EncoderMotor* motor);
+// 重新初始化编码器定时器之前调用：关闭更新中断并把当前位置存入 base
+void encoder_motor_suspend(EncoderMotor* motor);
+// 开关同步输出，开启前 PWM 通道须已使能比较值预装载，并在 PWM 定时器的更新中断中调用
+// encoder_motor_timer_update
+void encoder_motor_set_synchronized(EncoderMotor* motor, uint8_t enable);
+// 按控制频率 fs（Hz）更新测速比例，并清零一阶低通
+void encoder_motor_set_rate(EncoderMotor* motor, float fs);
+// 按模式驱动：0 正转，1 反转，2 制动，3 停止；speed 为 0 ~ full_speed
+void encoder_motor_drive(EncoderMotor* motor, uint8_t mode, uint16_t speed);
+// 按带符号的控制量驱动，正值正转，负值反转
+void encoder_motor_apply(EncoderMotor* motor, float output);
+// 在编码器定时器的更新中断中调用
+void encoder_motor_overflow(EncoderMotor* motor);
+// 在 PWM 定时器的更新中断（周期边界）中调用，完成推迟的方向切换
+void encoder_motor_pwm_update(EncoderMotor* motor);
+// 读取 64 位扩展位置（可在任意上下文调用）
+int64_t encoder_motor_read(EncoderMotor* motor);
+// 把当前位置设为零点
+void encoder_motor_zero(EncoderMotor* motor);
+// 采样扩展位置，更新 position，返回自上次采样以来的计数差
+int32_t encoder_motor_sample(EncoderMotor* motor);
+// 定点测速：counts 为本拍计数差，dt_cycles 为实测周期（DWT 周期数，0 时按标称周期）
+float encoder_motor_measure(EncoderMotor* motor, int32_t counts, uint32_t dt_cycles);
+// 采样、测速并运行速度环，dt 为实测周期（秒，0 时沿用 PID 的 Ts）
+void encoder_motor_update(EncoderMotor* motor, uint32_t dt_cycles, float dt);
+
+// 注册到控制节拍，返回序号，已满时返回 -1（重复注册返回原序号）
+int encoder_motor_register(EncoderMotor* motor);
+uint8_t encoder_motor_count();
+EncoderMotor* encoder_motor_get(uint8_t index);
+// 在 HAL_TIM_PeriodElapsedCallback 中调用，把编码器定时器的回绕和 PWM 定时器的周期边界
+// 分派给对应的电机
+void encoder_motor_timer_update(TIM_HandleTypeDef* htim);
+
+#endif
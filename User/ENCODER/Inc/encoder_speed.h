@@ -0,0 +1,53 @@
+#ifndef __ENCODER_SPEED_H
+#define __ENCODER_SPEED_H
+
+#include "biquad.h"
+#include <stdint.h>
+
+// 编码器分辨率（每转一圈的脉冲数）
+#define PULSES_PER_REVOLUTION 11.0f
+// 分频系数
+#define FREQUENCY_DOUBLING_COEFFICIENT 4
+// 减速比
+#define REDUCTION_RATIO 4.4
+// 输出轴每转的编码器计数
+#define COUNTS_PER_OUTPUT_REVOLUTION                                                               \
+    (PULSES_PER_REVOLUTION * FREQUENCY_DOUBLING_COEFFICIENT * REDUCTION_RATIO)
+// 编码器计数 -> 输出轴角度（度）
+#define COUNTS_TO_DEGREES(x) ((x)*360.0f / COUNTS_PER_OUTPUT_REVOLUTION)
+
+// 定点测速：计数差以 Q16 计数/节拍表示，一阶低通系数同为 Q16
+#define SPEED_FIXED_Q 16
+#define SPEED_EMA_COEFFICIENT 0.3f // 一阶低通系数（新测量值的权重）
+#define SPEED_EMA_Q16 ((int32_t)(SPEED_EMA_COEFFICIENT * (1L << SPEED_FIXED_Q) + 0.5f))
+// 实测周期与标称周期之比偏离 1 超过此值（漏拍、调试暂停）时改用除法折算
+#define SPEED_DT_RATIO_RANGE 0.25f
+
+// 测速观测器参数（单位为编码器计数、计数/节拍；卡尔曼过程噪声按秒给出，随控制周期换算）。
+// 按默认 10 Hz 节拍整定，匀速噪声和匀加速滞后都小于上面的一阶低通（test_speed_observer.c）；
+// α-β 取临界阻尼 β = α²/(2 - α)，加速度滞后 α/β - 1/2 ≈ 2.1 拍
+#define OBSERVER_ALPHA 0.55f // α-β观测器位置修正增益
+#define OBSERVER_BETA (OBSERVER_ALPHA * OBSERVER_ALPHA / (2.0f - OBSERVER_ALPHA))
+#define KALMAN_ACCEL_NOISE 10.0f // 卡尔曼过程噪声：加速度标准差（计数/秒²），10 Hz 时 α ≈ 0.56
+#define KALMAN_MEAS_NOISE 0.29f  // 卡尔曼测量噪声：量化噪声标准差（1/√12 计数）
+
+// 定点测速管线：Q16 计数差 -> 按实测周期折算 -> 可选的 Q31 滤波链 -> 一阶低通 -> 乘比例系数
+typedef struct
+{
+    float counts_to_speed;   // 计数/秒 -> 速度
+    float scale;             // Q16 计数/标称节拍 -> 速度，随控制频率更新
+    uint32_t nominal_cycles; // 标称节拍的周期数
+    uint32_t inv_nominal;    // 2^32 / nominal_cycles，与 dt_cycles 相乘后右移 16 位即 Q16 周期比
+    BiquadChainQ31* filter;  // 测速滤波链（Q31，处理 Q16 计数），为 NULL 时不滤波
+    int32_t counts;          // 一阶低通状态（Q16 计数/标称节拍）
+    float speed;             // 最近一次测得的速度
+} EncoderSpeed;
+
+// 清零状态，counts_to_speed 为计数/秒到速度单位的换算系数
+void encoder_speed_init(EncoderSpeed* meter, float counts_to_speed);
+// 按控制频率 fs（Hz）和周期计数器频率 clock_hz 更新比例系数和标称周期，并清零一阶低通
+void encoder_speed_set_rate(EncoderSpeed* meter, float fs, uint32_t clock_hz);
+// counts 为本拍计数差，dt_cycles 为实测周期（周期计数器的计数，0 时按标称周期），返回速度
+float encoder_speed_measure(EncoderSpeed* meter, int32_t counts, uint32_t dt_cycles);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef __LOOP_TIMER_H
+#define __LOOP_TIMER_H
+
+#include "main.h"
+
+// 基于 DWT 周期计数器的控制周期测量、抖动和 CPU 占用统计
+typedef struct
+{
+    float nominal;        // 标称周期（秒）
+    float cycle_to_s;     // 1 / SystemCoreClock，周期数 -> 秒
+    uint32_t last_cycles; // 上一次采样时的 DWT->CYCCNT
+    uint32_t samples;     // 已统计的采样次数
+    uint32_t dt_cycles;   // 最近一次实测周期（DWT 周期数）
+    float dt;             // 最近一次实测周期（秒）
+    float dt_min;         // 实测周期最小值
+    float dt_max;         // 实测周期最大值
+    float dt_mean;        // 实测周期均值
+    float dt_m2;          // Welford 算法的二阶中心矩累积量
+    float jitter_max;     // |dt - nominal| 的最大值
+    float busy;           // 最近一次控制中断从采样到结束的执行时间（秒）
+    float busy_max;       // 执行时间最大值
+    float busy_mean;      // 执行时间均值
+} LoopTimer;
+
+// 使能 DWT 周期计数器并清空统计，需在控制中断使能前调用
+void loop_timer_init(LoopTimer* timer, float nominal);
+// 在控制中断开头调用，返回距上一次调用的实测时间（秒）并更新统计
+float loop_timer_sample(LoopTimer* timer);
+// 在控制中断末尾调用，记录本次中断的执行时间
+void loop_timer_end(LoopTimer* timer);
+// 实测周期的标准差（秒）
+float loop_timer_jitter_rms(const LoopTimer* timer);
+// 控制中断的平均 CPU 占用率（0 ~ 1）
+float loop_timer_load(const LoopTimer* timer);
+
+#endif
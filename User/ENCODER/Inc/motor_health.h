@@ -0,0 +1,56 @@
+#ifndef __MOTOR_HEALTH_H
+#define __MOTOR_HEALTH_H
+
+#include <stdint.h>
+
+// 故障码，按检测顺序排列，第一次检出后锁存
+typedef enum
+{
+    MOTOR_FAULT_NONE = 0,  // 正常
+    MOTOR_FAULT_GLITCH,    // 编码器计数跳变：单拍计数差超出物理可能
+    MOTOR_FAULT_STALL,     // 堵转：大占空比下编码器几乎不动
+    MOTOR_FAULT_RUNAWAY,   // 飞车：仍在驱动时速度远超指令
+    MOTOR_FAULT_DIRECTION, // 方向不符：持续向驱动的反方向转动（接线或编码器极性错误）
+    MOTOR_FAULT_COUNT
+} MotorFault;
+
+// 电机健康监测：每个控制节拍检查一次，故障持续指定节拍数后锁存，直到 motor_health_clear
+typedef struct
+{
+    // 配置（控制量和速度的单位同调用方）
+    float stall_output;       // |控制量| 不低于此值视为大占空比
+    int32_t stall_counts;     // 堵转窗口内 |累计计数| 不超过此值视为未转动
+    float runaway_ratio;      // |速度| > |指令| * runaway_ratio + runaway_margin 视为飞车
+    float runaway_margin;     // 飞车判据的绝对裕量
+    float direction_output;   // |控制量| 不低于此值时才检查方向
+    float direction_speed;    // 反向 |速度| 超过此值视为方向不符
+    int32_t glitch_counts;    // 单拍 |计数差| 超过此值视为计数跳变
+    uint16_t stall_ticks;     // 堵转窗口的节拍数
+    uint16_t runaway_ticks;   // 飞车持续的节拍数
+    uint16_t direction_ticks; // 方向不符持续的节拍数
+    // 状态
+    uint16_t stall_count;     // 堵转窗口已经过的节拍数
+    int32_t stall_sum;        // 堵转窗口内的累计计数
+    uint16_t runaway_count;   // 飞车已持续的节拍数
+    uint16_t direction_count; // 方向不符已持续的节拍数
+    MotorFault fault;         // 锁存的故障码
+    float fault_value;        // 检出故障时的相关量（计数差、速度或累计计数）
+} MotorHealth;
+
+// 初始化配置并清除故障，节拍相关的量由 motor_health_set_timing 设置
+void motor_health_init(MotorHealth* health, float stall_output, int32_t stall_counts,
+                       float runaway_ratio, float runaway_margin, float direction_output,
+                       float direction_speed);
+// 设置与控制周期有关的量（控制频率改变时调用），不清除锁存的故障
+void motor_health_set_timing(MotorHealth* health, int32_t glitch_counts, uint16_t stall_ticks,
+                             uint16_t runaway_ticks, uint16_t direction_ticks);
+// 清除锁存的故障和各项计时
+void motor_health_clear(MotorHealth* health);
+// 每个控制节拍调用一次：output 为实际输出的带符号控制量，command 为速度指令，
+// speed 为测得的速度，counts 为本拍的编码器计数差；返回锁存的故障码
+MotorFault motor_health_update(MotorHealth* health, float output, float command, float speed,
+                               int32_t counts);
+// 故障码的简短名称（用于 OLED 和串口）
+char* motor_health_fault_name(MotorFault fault);
+
+#endif
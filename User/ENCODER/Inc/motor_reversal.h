@@ -0,0 +1,41 @@
+#ifndef __MOTOR_REVERSAL_H
+#define __MOTOR_REVERSAL_H
+
+#include <stdint.h>
+
+// 换向状态
+typedef enum
+{
+    MOTOR_REVERSAL_STOPPED = 0, // 桥臂关断（制动或滑行），可直接向任一方向起动
+    MOTOR_REVERSAL_FORWARD,     // 正转
+    MOTOR_REVERSAL_REVERSE,     // 反转
+    MOTOR_REVERSAL_DWELL        // 换向前的制动/滑行等待
+} MotorReversalState;
+
+// 换向状态机：把带符号的控制量转换为驱动模式（0 正转，1 反转，2 制动，3 滑行）和速度
+typedef struct
+{
+    // 配置（单位同控制量）
+    float full_scale;     // 满量程控制量
+    float hysteresis;     // 过零滞环：反向控制量超过此值才换向
+    float deadband;       // 死区补偿：非零输出叠加的静摩擦偏置
+    uint8_t dwell_mode;   // 换向等待和停止时的驱动模式，2 制动或 3 滑行
+    uint16_t dwell_ticks; // 换向等待的节拍数，至少为 1
+    // 状态
+    MotorReversalState state; // 当前状态
+    uint16_t dwell_count;     // 换向等待剩余节拍数
+    uint8_t mode;             // 本拍的驱动模式
+    float speed;              // 本拍的速度（0 ~ full_scale）
+} MotorReversal;
+
+// 初始化，状态为 STOPPED
+void motor_reversal_init(MotorReversal* reversal, float full_scale, float hysteresis,
+                         float deadband, uint8_t dwell_mode, uint16_t dwell_ticks);
+// 修改换向等待的节拍数（控制频率改变时调用），不影响当前状态
+void motor_reversal_set_dwell(MotorReversal* reversal, uint16_t dwell_ticks);
+// 驱动模式被直接设置时调用，使状态与桥臂一致（等待中的制动/滑行不打断等待）
+void motor_reversal_sync(MotorReversal* reversal, uint8_t mode);
+// 每个控制节拍调用一次，返回驱动模式，速度存于 speed
+uint8_t motor_reversal_update(MotorReversal* reversal, float output);
+
+#endif
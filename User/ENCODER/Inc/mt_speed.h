@@ -0,0 +1,39 @@
+#ifndef __MT_SPEED_H
+#define __MT_SPEED_H
+
+#include <stdint.h>
+
+// M/T 法测速：低速时用编码器边沿时间戳（T 法），高速时用采样周期内的计数差（M 法），按速度自动切换
+typedef struct
+{
+    // 配置
+    float cycle_to_s;      // 时间戳单位 -> 秒
+    float counts_per_edge; // 相邻两次捕获之间的编码器计数
+    float switch_high;     // |速度| 高于此值（计数/秒）时切换到 M 法
+    float switch_low;      // |速度| 低于此值（计数/秒）时切回 T 法
+    // 捕获中断写入的最近一个边沿（edges 最后写，读取时据此判断是否被中断打断）
+    volatile uint16_t edge_count;  // 边沿处的计数器值
+    volatile uint32_t edge_cycles; // 边沿的时间戳
+    volatile uint32_t edges;       // 已捕获的边沿数
+    // 采样节拍之间的状态
+    uint16_t prev_count;       // 上一次采样时的计数器值
+    uint32_t prev_cycles;      // 上一次采样的时间戳
+    uint16_t prev_edge_count;  // 上一个窗口最后一个边沿处的计数器值
+    uint32_t prev_edge_cycles; // 上一个窗口最后一个边沿的时间戳
+    uint32_t prev_edges;       // 上一次采样时的 edges
+    uint8_t edge_valid;        // prev_edge_* 是否有效（切到 T 法后的第一个边沿只作为起点）
+    uint8_t t_method;          // 1：T 法（需要捕获中断），0：M 法
+    float speed;               // 最近一次测得的速度（计数/秒）
+} MTSpeed;
+
+// 初始化：cycle_to_s 为时间戳的单位，switch_low < switch_high 构成切换滞环（计数/秒）
+void mt_speed_init(MTSpeed* mt, float cycle_to_s, float counts_per_edge, float switch_high,
+                   float switch_low);
+// 以当前计数器值和时间戳为起点，速度清零并回到 T 法
+void mt_speed_reset(MTSpeed* mt, uint16_t count, uint32_t now);
+// 在编码器捕获中断中调用，记录边沿处的计数器值和时间戳
+void mt_speed_capture(MTSpeed* mt, uint16_t count, uint32_t cycles);
+// 每个采样节拍调用一次，count 为计数器原始值（可回绕），返回速度（计数/秒）
+float mt_speed_update(MTSpeed* mt, uint16_t count, uint32_t now);
+
+#endif
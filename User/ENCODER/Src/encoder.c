@@ -20,10 +20,193 @@
 // 全局变量存储速度
 float motor_speed = 0.0f;
 
-// 滤波器系数
-float filter_coefficient = 0.3f;
+// 主电机实例（TIM1 CH1 + TIM3 + AIN1/AIN2），位置、定点测速状态都保存在其中
+EncoderMotor motor_main;
 
 PIDController pid;
+// 串级控制的外环（位置环）
+PIDController pid_position;
+PIDCascade pid_cascade;
+// 继电反馈自整定器
+PIDAutotune pid_autotune;
+// 开环阶跃测试
+PIDStepTest motor_step_test;
+
+// 速度环增益调度表（按输出轴转速绝对值升序，const 存放在 Flash 中）
+// 低速段静摩擦影响大，需要更强的积分；高速段对象增益高，比例和积分都要减小
+static const PIDGainPoint motor_gain_table[] = {
+    {0.0f,                   1.5f, 8.0f, 0.0f},
+    {0.25f * FULL_SPEED_RPM, 1.2f, 6.0f, 0.0f},
+    {0.6f * FULL_SPEED_RPM,  1.0f, 5.0f, 0.0f},
+    {FULL_SPEED_RPM,         0.8f, 4.0f, 0.0f},
+};
+PIDGainSchedule motor_gain_schedule;
+
+// 增量式速度环
+PIDVelocity pid_incremental;
+
+// 最近一次输出到电机的带符号控制量（正转为正，单位同Encoder_Motor_SetSpeed的speed）
+float motor_output = 0.0f;
+// 主电机的换向状态机，闭环控制量经过它再驱动H桥
+MotorReversal motor_reversal;
+// 主电机的健康监测，故障锁存到Motor_Health_Clear或下一次Encoder_Motor_Init
+MotorHealth motor_health;
+// 最近一次测速得到的编码器计数差，供健康监测使用
+static int32_t motor_tick_counts = 0;
+
+// 速度环是否叠加静态前馈
+uint8_t motor_feedforward_enabled = 1;
+
+// 当前控制模式
+MotorControlMode motor_control_mode = MOTOR_MODE_SPEED;
+
+// 当前测速估计器及其观测器状态
+MotorSpeedEstimator motor_speed_estimator = MOTOR_ESTIMATOR_EMA;
+SpeedObserver motor_observer;
+MTSpeed motor_mt_speed;
+
+// 目标值的 S 曲线轨迹（速度模式整形目标速度，串级模式整形目标位置）
+Trajectory motor_trajectory;
+uint8_t motor_trajectory_enabled = 0;
+
+// TIM2 控制周期的实测时间戳与抖动统计
+LoopTimer motor_loop_timer;
+// 测速和速度环是否使用实测周期（0 时使用标称周期 motor_control_period）
+uint8_t motor_measured_dt_enabled = 1;
+// TIM2 实际编程得到的控制周期（秒），由Motor_Set_Control_Rate修改
+float motor_control_period = MOTOR_CONTROL_PERIOD;
+// 同步输出：TIM1比较值和重装载值预装载，TIM2对TIM1的更新事件（TRGO）计数产生控制中断，
+// 方向切换推迟到PWM周期边界；在下一次Encoder_Motor_Init时生效
+uint8_t motor_pwm_sync_enabled = 1;
+
+// 当前回路的控制性能指标（在TIM2中断中逐拍更新）
+PIDMetrics motor_metrics;
+
+// 测速信号（PID之前）和控制量（PWM之前）的级联二阶节滤波链，节数为0时直通
+BiquadChain motor_speed_filter;
+BiquadChain motor_output_filter;
+// 测速滤波链的Q31副本，供定点测速使用
+BiquadChainQ31 motor_speed_filter_q31;
+
+// 速度环对象模型的在线辨识器
+PIDRls motor_rls;
+// 是否按辨识结果定期重整定速度环（极点配置PI）
+uint8_t motor_rls_retune_enabled       = 0;
+static uint32_t motor_rls_tick         = 0;
+static uint32_t motor_rls_retune_ticks = 1; // RLS_RETUNE_PERIOD对应的节拍数
+
+/**
+ * @brief 按控制频率设置TIM2的分频和重装载值
+ *
+ * 取使重装载值不超过16位的最小分频，使实际频率尽量接近目标。
+ * 同步输出时TIM2的计数时钟是TIM1的更新事件，控制周期为整数个PWM周期。
+ * 写入后立即产生更新事件使新的分频生效，并清除由此置位的更新标志，不会多触发一次控制中断。
+ * @param frequency 目标控制频率（Hz）
+ * @return 实际得到的控制频率（Hz）
+ */
+static float Motor_Program_Control_Timer(float frequency)
+{
+    // APB1分频不为1时定时器时钟为PCLK1的2倍
+    float clock = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+    {
+        clock *= 2;
+    }
+    if (motor_main.synchronized)
+    {
+        // TIM1挂在APB2上，计数时钟为其更新频率
+        clock = HAL_RCC_GetPCLK2Freq();
+        if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1)
+        {
+            clock *= 2;
+        }
+        clock /= (float)(htim1.Init.Prescaler + 1) * (htim1.Init.Period + 1);
+    }
+    uint32_t ticks = (uint32_t)(clock / frequency + 0.5f);
+    if (ticks < 2)
+    {
+        // 重装载值为0时计数器不工作，同步输出时控制频率最高为PWM频率的一半
+        ticks = 2;
+    }
+    uint32_t prescaler = (ticks + 0xFFFF) / 0x10000;
+    uint32_t period    = (ticks + prescaler / 2) / prescaler;
+    if (htim2.Instance == NULL)
+    {
+        // 尚未初始化时只计算实际频率，由Encoder_Motor_Init写入
+        return clock / (prescaler * period);
+    }
+
+    uint32_t update_enabled = __HAL_TIM_GET_IT_SOURCE(&htim2, TIM_IT_UPDATE);
+    __HAL_TIM_DISABLE_IT(&htim2, TIM_IT_UPDATE);
+    __HAL_TIM_SET_PRESCALER(&htim2, prescaler - 1);
+    __HAL_TIM_SET_AUTORELOAD(&htim2, period - 1);
+    htim2.Instance->EGR = TIM_EGR_UG;
+    __HAL_TIM_CLEAR_IT(&htim2, TIM_IT_UPDATE);
+    if (update_enabled)
+    {
+        __HAL_TIM_ENABLE_IT(&htim2, TIM_IT_UPDATE);
+    }
+    return clock / (prescaler * period);
+}
+
+/**
+ * @brief 配置同步输出
+ *
+ * TIM1开启比较值和重装载值预装载，更新事件作为TRGO输出；TIM2改为外部时钟模式1，
+ * 以ITR0（TIM1的TRGO）计数。控制中断总在PWM周期边界产生，计算出的比较值在其后的
+ * 第一个周期边界生效，采样到输出的延迟固定。需在MX_TIM1_Init、MX_TIM2_Init之后调用，
+ * 未开启同步输出时保持CubeMX的配置（TIM2使用内部时钟）。
+ */
+static void Motor_Pwm_Sync_Init()
+{
+    encoder_motor_set_synchronized(&motor_main, motor_pwm_sync_enabled);
+    if (!motor_pwm_sync_enabled)
+    {
+        return;
+    }
+
+    TIM_MasterConfigTypeDef master_config = {0};
+    TIM_SlaveConfigTypeDef slave_config   = {0};
+    __HAL_TIM_ENABLE_OCxPRELOAD(&htim1, TIM_CHANNEL_1);
+    htim1.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    htim1.Instance->CR1 |= TIM_CR1_ARPE;
+    master_config.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    master_config.MasterSlaveMode     = TIM_MASTERSLAVEMODE_DISABLE;
+    HAL_TIMEx_MasterConfigSynchronization(&htim1, &master_config);
+
+    slave_config.SlaveMode    = TIM_SLAVEMODE_EXTERNAL1;
+    slave_config.InputTrigger = TIM_TS_ITR0;
+    HAL_TIM_SlaveConfigSynchro(&htim2, &slave_config);
+}
+
+/**
+ * @brief 按控制周期把时间换算为节拍数
+ *
+ * 不足千分之一节拍的部分视为浮点舍入误差，不进位。
+ * @param time 时间（秒）
+ * @return 向上取整到控制周期的节拍数
+ */
+static uint32_t Motor_Time_To_Ticks(float time)
+{
+    float ticks = ceilf(time / motor_control_period - 0.001f);
+    return ticks > 0.0f ? (uint32_t)ticks : 0;
+}
+
+/**
+ * @brief 按控制周期设置健康监测的节拍数和计数跳变阈值
+ *
+ * 计数跳变阈值为满转速下一拍的计数乘以MOTOR_HEALTH_GLITCH_RATIO，另留一个编码器周期的余量。
+ */
+static void Motor_Health_Set_Timing()
+{
+    float full_counts = FULL_SPEED_RPM / COUNTS_TO_SPEED * motor_control_period;
+    motor_health_set_timing(&motor_health,
+                            (int32_t)ceilf(MOTOR_HEALTH_GLITCH_RATIO * full_counts) +
+                                FREQUENCY_DOUBLING_COEFFICIENT,
+                            Motor_Time_To_Ticks(MOTOR_HEALTH_STALL_TIME),
+                            Motor_Time_To_Ticks(MOTOR_HEALTH_RUNAWAY_TIME),
+                            Motor_Time_To_Ticks(MOTOR_HEALTH_DIRECTION_TIME));
+}
 
 /**
  * @brief 初始化编码器电机
@@ -34,53 +217,262 @@ PIDController pid;
  */
 void Encoder_Motor_Init()
 {
-    MX_GPIO_Init();                           // 初始化AIN端口
-    MX_TIM1_Init();                           // 初始化TIM1以产生PWM信号
-    MX_TIM2_Init();                           // 初始化TIM2以编码器模式运行
-    MX_TIM3_Init();                           // 初始化TIM3作为定时器记数使用
-    HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_1); // 启动TIM1的PWM模式通道1
+    if (motor_main.encoder_timer == NULL)
+    {
+        // 首次初始化：绑定主电机的硬件并注册到控制节拍
+        encoder_motor_init(&motor_main, &htim1, TIM_CHANNEL_1, &htim3, ENCODER_AIN1_GPIO_Port,
+                           ENCODER_AIN1_Pin, ENCODER_AIN2_GPIO_Port, ENCODER_AIN2_Pin,
+                           FULL_SPEED_RPM, COUNTS_TO_SPEED);
+        motor_main.meter.filter = &motor_speed_filter_q31;
+        encoder_motor_register(&motor_main);
+    }
+    else
+    {
+        // 重新初始化会把TIM3计数器清零，先保存当前位置
+        __HAL_TIM_DISABLE_IT(&htim3, TIM_IT_CC1);
+        encoder_motor_suspend(&motor_main);
+    }
+
+    MX_GPIO_Init(); // 初始化AIN端口
+    MX_TIM1_Init(); // 初始化TIM1以产生PWM信号
+    MX_TIM2_Init(); // 初始化TIM2以编码器模式运行
+    MX_TIM3_Init(); // 初始化TIM3作为定时器记数使用
+
+    // MX_TIM2_Init按CubeMX配置的10Hz初始化，这里切换时钟源并恢复当前的控制周期
+    Motor_Pwm_Sync_Init();
+    motor_control_period = 1.0f / Motor_Program_Control_Timer(1.0f / motor_control_period);
+
+    // 启动TIM1的PWM模式通道1和TIM3编码器，TIM3自由运行，回绕由更新中断维护
+    encoder_motor_start(&motor_main);
+
+    // 串级控制：位置环输出作为速度环（pid）的设定值，需在TIM2中断使能前完成
+    pid_cascade_init(&pid_cascade, &pid_position, &pid, POSITION_LOOP_DIVIDER,
+                     SPEED_LOOP_DIVIDER);
+    pid_schedule_init(&motor_gain_schedule, motor_gain_table,
+                      sizeof(motor_gain_table) / sizeof(motor_gain_table[0]));
+    loop_timer_init(&motor_loop_timer, motor_control_period);
+    Motor_Filter_Init(1.0f / motor_control_period);
+    // MX_GPIO_Init把方向引脚拉低，桥臂处于滑行状态
+    motor_reversal_init(&motor_reversal, FULL_SPEED_RPM, MOTOR_REVERSAL_HYSTERESIS,
+                        MOTOR_DEADBAND_COMPENSATION, MOTOR_REVERSAL_DWELL_MODE,
+                        Motor_Time_To_Ticks(MOTOR_REVERSAL_DWELL));
+    // 堵转判据：窗口内的累计计数不超过MOTOR_HEALTH_STALL_SPEED对应的计数
+    int32_t stall_counts =
+        (int32_t)(MOTOR_HEALTH_STALL_SPEED / COUNTS_TO_SPEED * MOTOR_HEALTH_STALL_TIME);
+    motor_health_init(&motor_health, MOTOR_HEALTH_STALL_OUTPUT, stall_counts,
+                      MOTOR_HEALTH_RUNAWAY_RATIO, MOTOR_HEALTH_RUNAWAY_MARGIN,
+                      MOTOR_HEALTH_DIRECTION_OUTPUT, MOTOR_HEALTH_DIRECTION_SPEED);
+    Motor_Health_Set_Timing();
+    mt_speed_init(&motor_mt_speed, motor_loop_timer.cycle_to_s, MT_COUNTS_PER_EDGE,
+                  MT_SWITCH_HIGH_EDGE_RATE * MT_COUNTS_PER_EDGE,
+                  MT_SWITCH_LOW_EDGE_RATE * MT_COUNTS_PER_EDGE);
+    Motor_Set_Speed_Estimator(motor_speed_estimator);
+    pid_rls_init(&motor_rls, RLS_FORGETTING_FACTOR, RLS_INITIAL_COVARIANCE, motor_control_period);
+    motor_rls_tick         = 0;
+    motor_rls_retune_ticks = Motor_Time_To_Ticks(RLS_RETUNE_PERIOD);
+    HAL_TIM_Base_Start_IT(&htim2); // 使能定时器2中断
+}
+/**
+ * @brief 按encoder.h中的默认参数配置测速和输出滤波链
+ *
+ * 两条滤波链和主电机定点一阶低通的状态清零，并按fs更新定点测速的比例系数。
+ * 运行中可直接用biquad_set_*重新设计已有的节，或用biquad_chain_add追加节，
+ * 修改测速滤波链后需调用Motor_Speed_Filter_Sync。
+ * @param fs 采样频率（Hz），应与TIM2中断频率一致
+ */
+void Motor_Filter_Init(float fs)
+{
+    encoder_motor_set_rate(&motor_main, fs);
+
+    biquad_chain_init(&motor_speed_filter);
+    biquad_chain_init(&motor_output_filter);
+    if (SPEED_FILTER_NOTCH_HZ > 0.0f)
+    {
+        biquad_set_notch(biquad_chain_add(&motor_speed_filter), SPEED_FILTER_NOTCH_HZ,
+                         SPEED_FILTER_NOTCH_Q, fs);
+    }
+    if (OUTPUT_FILTER_LOWPASS_HZ > 0.0f)
+    {
+        biquad_set_lowpass(biquad_chain_add(&motor_output_filter), OUTPUT_FILTER_LOWPASS_HZ,
+                           OUTPUT_FILTER_LOWPASS_Q, fs);
+    }
+    Motor_Speed_Filter_Sync();
+}
+
+/**
+ * @brief 把测速滤波链的系数同步到定点测速使用的Q31副本
+ *
+ * Q31副本的状态清零。滤波链是线性的，Q31版本可直接处理Q16计数，不需要归一化。
+ */
+void Motor_Speed_Filter_Sync()
+{
+    biquad_chain_q31_from_float(&motor_speed_filter_q31, &motor_speed_filter);
+}
+
+/**
+ * @brief 修改控制频率
+ *
+ * 重新设置TIM2，并把实际得到的采样周期同步到所有依赖它的地方：周期统计、测速和输出滤波链、
+ * 卡尔曼观测器增益、在线辨识、换向等待和健康监测的节拍数以及速度环/位置环/增量式PID的采样周期
+ * （PID增益保持不变），
+ * 其余注册的电机也同步更新测速比例和速度环采样周期。
+ * 正在运行的轨迹和性能统计也改用新周期；增量式PID保留当前控制量，运行中切换不会使输出跳变。
+ * @param frequency 目标控制频率（Hz），限制在MOTOR_CONTROL_RATE_MIN ~ MOTOR_CONTROL_RATE_MAX
+ * @return 实际得到的控制频率（Hz）
+ */
+float Motor_Set_Control_Rate(float frequency)
+{
+    if (frequency < MOTOR_CONTROL_RATE_MIN)
+    {
+        frequency = MOTOR_CONTROL_RATE_MIN;
+    }
+    if (frequency > MOTOR_CONTROL_RATE_MAX)
+    {
+        frequency = MOTOR_CONTROL_RATE_MAX;
+    }
+    float achieved       = Motor_Program_Control_Timer(frequency);
+    float Ts             = 1.0f / achieved;
+    motor_control_period = Ts;
+    if (htim3.Instance == NULL)
+    {
+        // 电机尚未初始化，Encoder_Motor_Init会按新周期初始化各模块
+        return achieved;
+    }
+
+    loop_timer_init(&motor_loop_timer, Ts);
+    Motor_Filter_Init(achieved);
+    // 卡尔曼增益与每拍的过程噪声有关，按新节拍重新计算
+    Motor_Set_Speed_Estimator(motor_speed_estimator);
+    pid_rls_init(&motor_rls, RLS_FORGETTING_FACTOR, RLS_INITIAL_COVARIANCE, Ts);
+    motor_rls_retune_ticks = Motor_Time_To_Ticks(RLS_RETUNE_PERIOD);
+    motor_reversal_set_dwell(&motor_reversal, Motor_Time_To_Ticks(MOTOR_REVERSAL_DWELL));
+    Motor_Health_Set_Timing();
+
+    uint8_t speed_divider = motor_control_mode == MOTOR_MODE_CASCADE ? SPEED_LOOP_DIVIDER : 1;
+    pid_set_sample_time(&pid, Ts * speed_divider, pid.tau);
+    pid_set_sample_time(&pid_position, Ts * POSITION_LOOP_DIVIDER, pid_position.tau);
+    pid_velocity_set_sample_time(&pid_incremental, Ts, pid_incremental.tau);
+    motor_trajectory.Ts = Ts;
+    motor_metrics.Ts    = Ts;
+
+    // 其余注册的电机
+    for (uint8_t i = 1; i < encoder_motor_count(); i++)
+    {
+        EncoderMotor* motor = encoder_motor_get(i);
+        encoder_motor_set_rate(motor, achieved);
+        if (motor->pid != NULL)
+        {
+            pid_set_sample_time(motor->pid, Ts, motor->pid->tau);
+        }
+    }
+    return achieved;
+}
+
+/**
+ * @brief 获取当前控制频率
+ * @return TIM2实际编程得到的控制频率（Hz）
+ */
+float Motor_Control_Rate()
+{
+    return 1.0f / motor_control_period;
+}
+
+/**
+ * @brief 获取控制中断的CPU占用率
+ *
+ * 按自上次Encoder_Motor_Init或Motor_Set_Control_Rate以来的平均执行时间与平均周期计算。
+ * @return CPU占用率（0 ~ 1）
+ */
+float Motor_Control_Load()
+{
+    return loop_timer_load(&motor_loop_timer);
+}
+
+/**
+ * @brief 打开或关闭编码器A相边沿的捕获中断
+ *
+ * 关闭期间CCR1仍会捕获，打开前先清除挂起的标志，避免用旧的捕获值打上新的时间戳。
+ * @param enable 1 打开，0 关闭
+ */
+static void Motor_Edge_Capture(uint8_t enable)
+{
+    if (enable)
+    {
+        if (!__HAL_TIM_GET_IT_SOURCE(&htim3, TIM_IT_CC1))
+        {
+            __HAL_TIM_CLEAR_IT(&htim3, TIM_IT_CC1);
+            __HAL_TIM_ENABLE_IT(&htim3, TIM_IT_CC1);
+        }
+    }
+    else
+    {
+        __HAL_TIM_DISABLE_IT(&htim3, TIM_IT_CC1);
+    }
+}
+
+/**
+ * @brief 选择测速估计器
+ *
+ * 观测器以当前位置为初值、速度清零重新开始，可在运行中切换。
+ * 只有M/T法需要TIM3的捕获中断，切到其他估计器时关闭。
+ * @param estimator 测速估计器
+ */
+void Motor_Set_Speed_Estimator(MotorSpeedEstimator estimator)
+{
+    if (estimator == MOTOR_ESTIMATOR_KALMAN)
+    {
+        // 过程噪声按当前控制周期换算为每拍的加速度（计数/节拍²）
+        float accel_noise = KALMAN_ACCEL_NOISE * motor_control_period * motor_control_period;
+        speed_observer_init_kalman(&motor_observer, accel_noise, KALMAN_MEAS_NOISE);
+    }
+    else
+    {
+        speed_observer_init_alpha_beta(&motor_observer, OBSERVER_ALPHA, OBSERVER_BETA);
+    }
+    speed_observer_reset(&motor_observer, (uint16_t)motor_main.last);
+    Motor_Edge_Capture(0);
+    if (estimator == MOTOR_ESTIMATOR_MT)
+    {
+        mt_speed_reset(&motor_mt_speed, (uint16_t)motor_main.last, motor_loop_timer.last_cycles);
+        Motor_Edge_Capture(1);
+    }
+    motor_speed_estimator = estimator;
+}
 
-    HAL_TIM_Encoder_Start(&htim3, TIM_CHANNEL_1); // 开启编码器A
-    HAL_TIM_Encoder_Start(&htim3, TIM_CHANNEL_2); // 开启编码器B
-    HAL_TIM_Base_Start_IT(&htim2);                // 使能定时器2中断
+/**
+ * @brief TIM3 输入捕获回调
+ *
+ * 编码器A相上升沿时CCR1锁存计数器值，这里补上DWT时间戳交给M/T法测速。
+ */
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef* htim)
+{
+    if (htim == &htim3 && htim->Channel == HAL_TIM_ACTIVE_CHANNEL_1)
+    {
+        mt_speed_capture(&motor_mt_speed, HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL_1),
+                         DWT->CYCCNT);
+    }
 }
+
 /**
  * @brief 设置编码器电机的速度和运行模式
  *
  * 该函数根据输入的模式和速度值来控制电机的运行。
  * 模式参数用于设置电机的旋转方向和制动状态，速度参数用于设置电机的转速。
- * @param mode 电机运行模式，0和1用于正反向旋转，2和3用于制动
+ * 直接调用时立即生效，并同步换向状态机：0/1使其进入对应方向，2/3（换向等待中除外）使其进入停止，
+ * 此后闭环从停止状态起动时不需要再等待。健康监测锁存故障后，0/1被替换为3（滑行），输出保持切断。
+ * @param mode 电机运行模式，0和1用于正反向旋转，2为制动（短路刹车），3为停止（滑行）
  * @param speed 电机速度rps，范围0-FULL_SPEED_RPM，实际PWM占空比为(speed/FULL_SPEED_RPM) * 72
  */
 void Encoder_Motor_SetSpeed(uint8_t mode, uint16_t speed)
 {
-    switch (mode)
+    if (motor_health.fault != MOTOR_FAULT_NONE && mode < 2)
     {
-    case 0:
-        // 设置电机正向旋转
-        Encoder_Motor_AIN1(0);
-        Encoder_Motor_AIN2(1);
-        __HAL_TIM_SET_COMPARE(&htim1, TIM_CHANNEL_1, (speed / FULL_SPEED_RPM) * 7200);
-        break;
-    case 1:
-        // 设置电机反向旋转
-        Encoder_Motor_AIN1(1);
-        Encoder_Motor_AIN2(0);
-        __HAL_TIM_SET_COMPARE(&htim1, TIM_CHANNEL_1, (speed / FULL_SPEED_RPM) * 7200);
-        break;
-    case 2:
-        // 设置电机制动状态（正向制动）
-        Encoder_Motor_AIN1(1);
-        Encoder_Motor_AIN2(1);
-        break;
-    case 3:
-        // 设置电机制动状态（停止）
-        Encoder_Motor_AIN1(0);
-        Encoder_Motor_AIN2(0);
-        break;
-    default:
-        break;
+        mode  = 3;
+        speed = 0;
     }
+    encoder_motor_drive(&motor_main, mode, speed);
+    motor_output = motor_main.output;
+    motor_reversal_sync(&motor_reversal, mode);
 }
 
 /**
@@ -90,12 +482,8 @@ void Encoder_Motor_SetSpeed(uint8_t mode, uint16_t speed)
  */
 void motor_positive()
 {
-    // 设置电机输入引脚AIN1为低电平
-    Encoder_Motor_AIN1(0);
-    // 设置电机输入引脚AIN2为高电平
-    Encoder_Motor_AIN2(1);
-    // 设置TIM1通道1的比较值为7200，控制电机正转速度
-    __HAL_TIM_SET_COMPARE(&htim1, TIM_CHANNEL_1, 7200);
+    // AIN1低、AIN2高，TIM1通道1比较值为满量程
+    Encoder_Motor_SetSpeed(0, (uint16_t)FULL_SPEED_RPM);
 }
 
 /**
@@ -105,12 +493,122 @@ void motor_positive()
  */
 void motor_reverse()
 {
-    // 设置电机输入引脚AIN1为高电平
-    Encoder_Motor_AIN1(1);
-    // 设置电机输入引脚AIN2为低电平
-    Encoder_Motor_AIN2(0);
-    // 设置TIM1通道1的比较值为7200，控制电机反转速度
-    __HAL_TIM_SET_COMPARE(&htim1, TIM_CHANNEL_1, 7200);
+    // AIN1高、AIN2低，TIM1通道1比较值为满量程
+    Encoder_Motor_SetSpeed(1, (uint16_t)FULL_SPEED_RPM);
+}
+
+/**
+ * @brief 读取主电机的64位扩展编码器位置
+ * @return 自TIM3首次初始化以来的累计编码器计数
+ */
+int64_t Motor_Encoder_Read()
+{
+    return encoder_motor_read(&motor_main);
+}
+
+/**
+ * @brief 把输出轴当前位置设为零点
+ *
+ * 只移动零点，不清零硬件计数器，测速和观测器不受影响。
+ * 可在Encoder_Motor_Init之前调用：主电机尚未绑定硬件时直接返回，首次绑定时位置本就从零开始。
+ */
+void Motor_Position_Zero()
+{
+    if (motor_main.encoder_timer == NULL)
+    {
+        return;
+    }
+    encoder_motor_zero(&motor_main);
+}
+
+/**
+ * @brief 读取编码器计数并更新电机速度
+ *
+ * 由64位扩展位置求出自上次调用以来的计数差，并更新主电机的位置。
+ * 速度按motor_speed_estimator选择的方法得到：计数差换算后一阶低通，
+ * 由α-β / 卡尔曼观测器根据累计计数估计，或用M/T法由边沿时间戳测得。
+ * 采样间隔取DWT实测值，中断被延后或TIM2周期改变时速度仍然准确。
+ */
+static void Motor_Measure_Speed()
+{
+    // 给本次采样打时间戳，得到距上次采样的实际间隔
+    float dt = loop_timer_sample(&motor_loop_timer);
+    if (!motor_measured_dt_enabled)
+    {
+        dt = motor_control_period;
+    }
+    // 读取扩展位置，得到自上次测速以来的计数差（不受16位计数器回绕影响）
+    int32_t counter_diff = encoder_motor_sample(&motor_main);
+    uint16_t counter     = (uint16_t)motor_main.last;
+    motor_tick_counts    = counter_diff;
+
+    if (motor_speed_estimator == MOTOR_ESTIMATOR_MT)
+    {
+        // 以loop_timer本拍的时间戳为采样时刻，与边沿时间戳同一时基
+        float counts_per_second =
+            mt_speed_update(&motor_mt_speed, counter, motor_loop_timer.last_cycles);
+        // 高速时M法已足够精确，关闭捕获中断以免中断频率随转速无限增加
+        Motor_Edge_Capture(motor_mt_speed.t_method);
+        motor_speed =
+            biquad_chain_process(&motor_speed_filter, counts_per_second * COUNTS_TO_SPEED);
+    }
+    else if (motor_speed_estimator != MOTOR_ESTIMATOR_EMA)
+    {
+        // 观测器给出的是计数/节拍，换算为输出轴速度后再经过测速滤波链
+        speed_observer_update(&motor_observer, counter);
+        float counts_per_second = speed_observer_velocity(&motor_observer) / dt;
+        motor_speed =
+            biquad_chain_process(&motor_speed_filter, counts_per_second * COUNTS_TO_SPEED);
+    }
+    else
+    {
+        // 定点测速：Q16计数/标称节拍 -> Q31测速滤波链 -> 定点一阶低通，最后乘一次比例系数
+        uint32_t dt_cycles = motor_measured_dt_enabled ? motor_loop_timer.dt_cycles : 0;
+        motor_speed        = encoder_motor_measure(&motor_main, counter_diff, dt_cycles);
+    }
+}
+
+/**
+ * @brief 按带符号的控制量驱动电机
+ * 控制量先经过输出滤波链，再由换向状态机决定驱动模式：过零时先按MOTOR_REVERSAL_DWELL_MODE
+ * 制动或滑行若干拍再反向，滞环内保持原方向，非零输出叠加死区补偿。
+ * @param output 控制量，正值正转，负值反转，绝对值为速度（同Encoder_Motor_SetSpeed）
+ */
+static void Motor_Apply_Output(float output)
+{
+    output       = biquad_chain_process(&motor_output_filter, output);
+    uint8_t mode = motor_reversal_update(&motor_reversal, output);
+    Encoder_Motor_SetSpeed(mode, (uint16_t)motor_reversal.speed);
+}
+
+/**
+ * @brief 运行一次健康监测，检出故障时切断输出
+ *
+ * 在本拍的测速和输出之后调用，故障锁存后Encoder_Motor_SetSpeed不再接受正反转。
+ * @param command 本拍的速度指令（开环模式传入FULL_SPEED_RPM，只检查明显超出满转速的飞车）
+ */
+static void Motor_Health_Check(float command)
+{
+    if (motor_health_update(&motor_health, motor_output, command, motor_speed,
+                            motor_tick_counts) != MOTOR_FAULT_NONE)
+    {
+        Encoder_Motor_SetSpeed(3, 0);
+    }
+}
+
+/**
+ * @brief 服务主电机以外的注册电机
+ *
+ * 每个电机按各自的setpoint和pid运行一次定点测速和速度闭环，与主电机共用本拍的实测周期。
+ */
+static void Motor_Update_Secondary()
+{
+    uint32_t dt_cycles = motor_measured_dt_enabled ? motor_loop_timer.dt_cycles : 0;
+    float dt           = motor_measured_dt_enabled ? motor_loop_timer.dt : 0.0f;
+    for (uint8_t i = 1; i < encoder_motor_count(); i++)
+    {
+        encoder_motor_update(encoder_motor_get(i), dt_cycles, dt);
+    }
 }
 
 /**
@@ -120,50 +618,410 @@ void motor_reverse()
  */
 void Motor_Speed()
 {
-    // 假设TIM2的中断频率为10Hz，即dt = 0.1秒
-    float dt = 0.1f;
-    // 读取TIM3的计数值
-    int16_t counter_diff = (int)((int16_t)__HAL_TIM_GET_COUNTER(&htim3));
+    Motor_Measure_Speed();
+
+    // 手动控制期间让增量式PID跟踪实际控制量，切回闭环时无扰
+    pid_velocity_track(&pid_incremental, motor_output, motor_speed, motor_speed);
+
+    Motor_Health_Check(FULL_SPEED_RPM);
+    Motor_Update_Secondary();
+    loop_timer_end(&motor_loop_timer);
+}
+
+/**
+ * @brief 速度环静态前馈
+ *
+ * 由FULL_SPEED_RPM对应满占空比推出转速到控制量的线性映射，并加上静摩擦补偿，
+ * 使PID只需修正剩余误差。
+ * @param target_speed 目标速度
+ * @return 前馈控制量（单位同Encoder_Motor_SetSpeed的speed，带符号）
+ */
+float Motor_Speed_Feedforward(float target_speed)
+{
+    if (target_speed > FEEDFORWARD_DEADBAND)
+    {
+        return FEEDFORWARD_GAIN * target_speed + FEEDFORWARD_STATIC_FRICTION;
+    }
+    if (target_speed < -FEEDFORWARD_DEADBAND)
+    {
+        return FEEDFORWARD_GAIN * target_speed - FEEDFORWARD_STATIC_FRICTION;
+    }
+    return 0.0f;
+}
+
+/**
+ * @brief 在线辨识速度环对象并按需重整定
+ *
+ * 用本拍实际输出的控制量和测得的转速（均按FULL_SPEED_RPM归一化）更新一阶模型。
+ * motor_rls_retune_enabled为1且置信度足够时，每RLS_RETUNE_PERIOD秒按极点配置无扰写入PI参数。
+ */
+static void Motor_Rls_Update()
+{
+    pid_rls_update(&motor_rls, motor_output / FULL_SPEED_RPM, motor_speed / FULL_SPEED_RPM);
 
-    float speed_rps =
-        ((counter_diff / PULSES_PER_REVOLUTION / FREQUENCY_DOUBLING_COEFFICIENT) * (1.0f / dt)) /
-        REDUCTION_RATIO; // 计算速度（转/秒）
-    motor_speed =
-        filter_coefficient * SPEED_TO_RPM(speed_rps) + (1.0f - filter_coefficient) * motor_speed;
+    if (!motor_rls_retune_enabled || ++motor_rls_tick < motor_rls_retune_ticks)
+    {
+        return;
+    }
+    motor_rls_tick = 0;
 
-    __HAL_TIM_SET_COUNTER(&htim3, 0);
+    float K, tau, kp, ki;
+    if (pid_rls_confidence(&motor_rls) >= RLS_MIN_CONFIDENCE &&
+        pid_rls_model(&motor_rls, &K, &tau) &&
+        pid_rls_pole_placement(&motor_rls, RLS_DAMPING, RLS_BANDWIDTH_RATIO / tau, &kp, &ki))
+    {
+        pid_set_gains(&pid, kp, ki, pid.Kd);
+    }
 }
 
 void Update_Motor_Speed(float setpoint)
 {
-    // 假设TIM2的中断频率为10Hz，即dt = 0.1秒
-    float dt = 0.1f;
-    // 读取TIM3的计数值
-    int16_t counter_diff = (int)((int16_t)__HAL_TIM_GET_COUNTER(&htim3));
+    Motor_Measure_Speed();
+
+    // 使用PID控制器计算新的PWM占空比（叠加静态前馈）
+    float feedforward = motor_feedforward_enabled ? Motor_Speed_Feedforward(setpoint) : 0.0f;
+    // 使用实测周期时积分和微分按实际经过的时间缩放，dt为0时按标称的pid.Ts计算
+    float dt     = motor_measured_dt_enabled ? motor_loop_timer.dt : 0.0f;
+    float newPWM = pid_update_ff_dt(&pid, setpoint, motor_speed, feedforward, dt);
+
+    // 设置电机速度为计算出的PWM值
+    Motor_Apply_Output(newPWM);
+
+    Motor_Rls_Update();
+}
+
+/**
+ * @brief 增益调度速度控制
+ *
+ * 该函数在TIM2中断中调用。先按当前转速在motor_gain_table中插值得到增益，
+ * 再以无扰方式写入pid，最后执行一次速度闭环。
+ * @param setpoint 目标速度
+ */
+void Update_Motor_Speed_Scheduled(float setpoint)
+{
+    pid_schedule_apply(&motor_gain_schedule, &pid, fabsf(motor_speed));
+    Update_Motor_Speed(setpoint);
+}
+
+/**
+ * @brief 增量式速度控制
+ *
+ * 该函数在TIM2中断中调用。pid_incremental在上一拍控制量上累加增量，
+ * 进入闭环前需用pid_velocity_track把它对齐到motor_output。
+ * @param setpoint 目标速度
+ */
+void Update_Motor_Speed_Incremental(float setpoint)
+{
+    Motor_Measure_Speed();
+
+    Motor_Apply_Output(pid_velocity_update(&pid_incremental, setpoint, motor_speed));
+}
+
+/**
+ * @brief 获取输出轴当前位置
+ * @return 自上次清零以来输出轴转过的角度（度），取最近一次测速时的位置
+ */
+float Motor_Position_Degrees()
+{
+    return COUNTS_TO_DEGREES((float)motor_main.position);
+}
+
+/**
+ * @brief 获取相对零点的编码器计数
+ *
+ * 直接读取硬件计数器，不依赖TIM2中断，可在任意时刻调用。
+ * @return 自Motor_Position_Zero以来的编码器计数
+ */
+int64_t Motor_Position_Counts()
+{
+    return encoder_motor_read(&motor_main) - motor_main.offset;
+}
+
+/**
+ * @brief 获取输出轴速度
+ * @return 最近一次测速得到的速度（单位同motor_speed）
+ */
+float Motor_Velocity()
+{
+    return motor_speed;
+}
+
+/**
+ * @brief 获取主电机锁存的故障码
+ * @return 健康监测锁存的故障码，正常时为MOTOR_FAULT_NONE
+ */
+MotorFault Motor_Fault()
+{
+    return motor_health.fault;
+}
+
+/**
+ * @brief 清除主电机锁存的故障
+ *
+ * 清除后Encoder_Motor_SetSpeed重新接受正反转，应在排除故障原因后调用。
+ */
+void Motor_Health_Clear()
+{
+    motor_health_clear(&motor_health);
+}
 
-    float speed_rps =
-        ((counter_diff / PULSES_PER_REVOLUTION / FREQUENCY_DOUBLING_COEFFICIENT) * (1.0f / dt)) /
-        REDUCTION_RATIO; // 计算速度（转/秒）
+/**
+ * @brief 串级位置控制
+ *
+ * 该函数在TIM2中断中调用。外环根据位置误差每POSITION_LOOP_DIVIDER个节拍给出一次速度设定值，
+ * 内环（pid）每SPEED_LOOP_DIVIDER个节拍根据速度误差更新一次PWM。
+ * 调用前需用pid_cascade_init把pid_position和pid挂到pid_cascade上。
+ * @param target_position 目标位置（输出轴角度，单位度）
+ */
+void Update_Motor_Position(float target_position)
+{
+    Motor_Measure_Speed();
 
-    // 使用简单的滤波器
-    motor_speed =
-        filter_coefficient * SPEED_TO_RPM(speed_rps) + (1.0f - filter_coefficient) * motor_speed;
+    float newPWM =
+        pid_cascade_update(&pid_cascade, target_position, Motor_Position_Degrees(), motor_speed);
 
-    // 使用PID控制器计算新的PWM占空比
-    float newPWM = pid_update(&pid, setpoint, motor_speed);
+    Motor_Apply_Output(newPWM);
+}
 
-    if (newPWM >= 0)
+/**
+ * @brief 启动继电反馈自整定
+ *
+ * 以setpoint为振荡中心、setpoint±AUTOTUNE_RELAY_AMPLITUDE为继电输出驱动电机，
+ * 继电幅值会被收窄以保证输出不超过FULL_SPEED_RPM。
+ * @param setpoint 自整定的目标速度
+ * @param Ts 采样周期（秒），应与TIM2中断周期一致
+ */
+void Motor_Autotune_Start(float setpoint, float Ts)
+{
+    float amplitude = AUTOTUNE_RELAY_AMPLITUDE;
+    if (fabsf(setpoint) + amplitude > FULL_SPEED_RPM)
+    {
+        amplitude = FULL_SPEED_RPM - fabsf(setpoint);
+    }
+    pid_autotune_init(&pid_autotune, setpoint, setpoint, amplitude, AUTOTUNE_HYSTERESIS, Ts,
+                      Motor_Time_To_Ticks(AUTOTUNE_TIMEOUT), AUTOTUNE_CYCLES);
+}
+
+/**
+ * @brief 继电反馈自整定
+ *
+ * 该函数在TIM2中断中调用。自整定进行中时按继电输出驱动电机，结束（成功或失败）后停止电机。
+ */
+void Update_Motor_Autotune()
+{
+    Motor_Measure_Speed();
+
+    if (pid_autotune.state == PID_AUTOTUNE_RUNNING)
+    {
+        float relay_output = pid_autotune_update(&pid_autotune, motor_speed);
+        if (pid_autotune.state == PID_AUTOTUNE_RUNNING)
+        {
+            Motor_Apply_Output(relay_output);
+            return;
+        }
+    }
+    Encoder_Motor_SetSpeed(3, 0);
+}
+
+/**
+ * @brief 把自整定结果写入速度环PID
+ * @param rule 整定规则
+ * @return 1 表示已写入，0 表示自整定未成功完成
+ */
+uint8_t Motor_Autotune_Apply(PIDTuneRule rule)
+{
+    float kp, ki, kd;
+    if (!pid_autotune_gains(&pid_autotune, rule, &kp, &ki, &kd))
+    {
+        return 0;
+    }
+    pid_set_gains(&pid, kp, ki, kd);
+    return 1;
+}
+
+/**
+ * @brief 启动开环阶跃测试
+ *
+ * 先以STEP_TEST_INITIAL_OUTPUT运行STEP_TEST_BASELINE_TIME秒记录基线，再阶跃到output，
+ * 把motor_speed记录到环形缓冲区直到写满。记录间隔取整数个控制节拍，
+ * 使缓冲区至少覆盖STEP_TEST_RECORD_TIME秒的响应。
+ * @param output 阶跃后的控制量（单位同Encoder_Motor_SetSpeed的speed），为0时使用默认值
+ * @param Ts 采样周期（秒），应与TIM2中断周期一致
+ */
+void Motor_Step_Test_Start(float output, float Ts)
+{
+    if (output == 0.0f)
+    {
+        output = STEP_TEST_DEFAULT_OUTPUT;
+    }
+    if (fabsf(output) > FULL_SPEED_RPM)
+    {
+        output = output > 0 ? FULL_SPEED_RPM : -FULL_SPEED_RPM;
+    }
+    // 阶跃前的控制量与阶跃同向，避免测试中途换向
+    float initial = output > 0 ? STEP_TEST_INITIAL_OUTPUT : -STEP_TEST_INITIAL_OUTPUT;
+    uint32_t record_ticks = Motor_Time_To_Ticks(STEP_TEST_RECORD_TIME);
+    uint32_t record_span  = PID_STEP_TEST_SAMPLES - PID_STEP_TEST_PRE_SAMPLES;
+    uint16_t decimation   = (uint16_t)((record_ticks + record_span - 1) / record_span);
+    pid_step_test_init(&motor_step_test, initial, output, Ts,
+                       Motor_Time_To_Ticks(STEP_TEST_BASELINE_TIME), decimation);
+}
+
+/**
+ * @brief 开环阶跃测试
+ *
+ * 该函数在TIM2中断中调用。记录中按阶跃测试给出的控制量驱动电机，记录完成后停止电机。
+ * 拟合在主循环中调用pid_step_test_fit完成。
+ */
+void Update_Motor_Step_Test()
+{
+    Motor_Measure_Speed();
+
+    if (motor_step_test.state == PID_STEP_TEST_BASELINE ||
+        motor_step_test.state == PID_STEP_TEST_RECORDING)
     {
-        Encoder_Motor_SetSpeed(0, (uint16_t)newPWM);
+        float output = pid_step_test_update(&motor_step_test, motor_speed);
+        if (motor_step_test.state != PID_STEP_TEST_DONE)
+        {
+            Motor_Apply_Output(output);
+            return;
+        }
+    }
+    Encoder_Motor_SetSpeed(3, 0);
+}
+
+/**
+ * @brief 把阶跃测试拟合出的参数写入速度环PID
+ * @param rule 整定规则
+ * @return 1 表示已写入，0 表示尚未拟合成功
+ */
+uint8_t Motor_Step_Test_Apply(PIDFopdtRule rule)
+{
+    float kp, ki, kd;
+    if (!pid_step_test_gains(&motor_step_test, rule, &kp, &ki, &kd))
+    {
+        return 0;
+    }
+    // 模型增益以控制量为输入、转速为输出，与速度环PID的量纲一致
+    pid_set_gains(&pid, kp, ki, kd);
+    return 1;
+}
+
+/**
+ * @brief 按当前控制模式初始化S曲线轨迹
+ *
+ * 串级模式下轨迹输出目标位置，其余模式输出目标速度。轨迹从电机当前的位置/速度出发，
+ * 启用时不会产生设定值跳变。需在TIM2中断使能前调用。
+ * @param Ts 采样周期（秒），应与TIM2中断周期一致
+ */
+void Motor_Trajectory_Start(float Ts)
+{
+    if (motor_control_mode == MOTOR_MODE_CASCADE)
+    {
+        traj_init(&motor_trajectory, TRAJ_MODE_POSITION, TRAJ_POSITION_MAX_VEL,
+                  TRAJ_POSITION_MAX_ACC, TRAJ_POSITION_MAX_JERK, Ts);
+        traj_reset(&motor_trajectory, Motor_Position_Degrees(), 0.0f);
     }
     else
     {
-        Encoder_Motor_SetSpeed(1, (uint16_t)fabs(newPWM));
+        traj_init(&motor_trajectory, TRAJ_MODE_VELOCITY, FULL_SPEED_RPM, TRAJ_SPEED_MAX_ACC,
+                  TRAJ_SPEED_MAX_JERK, Ts);
+        traj_reset(&motor_trajectory, 0.0f, motor_speed);
     }
+}
 
-    // 设置电机速度为计算出的PWM值
+/**
+ * @brief 开始统计当前回路的控制性能指标
+ *
+ * 以电机当前的速度（串级模式下为位置）作为阶跃起点。需在TIM2中断使能前调用。
+ * @param setpoint 目标值（速度模式为目标速度，串级模式为目标位置，单位度）
+ * @param Ts 采样周期（秒）
+ */
+void Motor_Metrics_Start(float setpoint, float Ts)
+{
+    float initial =
+        motor_control_mode == MOTOR_MODE_CASCADE ? Motor_Position_Degrees() : motor_speed;
+    pid_metrics_init(&motor_metrics, initial, setpoint, METRICS_SETTLING_BAND, Ts);
+}
+
+/**
+ * @brief 按当前控制模式执行一次控制
+ *
+ * 该函数在TIM2中断中调用，根据motor_control_mode分派到对应的控制函数。
+ * motor_trajectory_enabled为1时，目标值先经过S曲线轨迹整形再送给控制回路。
+ * 控制完成后更新motor_metrics（自整定和阶跃测试模式除外），指标相对Motor_Metrics_Start给出的
+ * 最终目标统计，启用S曲线轨迹时轨迹本身的过渡时间也计入。
+ * @param target_speed 目标速度（速度模式）
+ * @param target_position 目标位置（串级模式，单位度）
+ */
+void Update_Motor_Control(float target_speed, float target_position)
+{
+
+    if (motor_trajectory_enabled && motor_control_mode != MOTOR_MODE_AUTOTUNE &&
+        motor_control_mode != MOTOR_MODE_STEP_TEST)
+    {
+        if (motor_control_mode == MOTOR_MODE_CASCADE)
+        {
+            traj_set_target(&motor_trajectory, target_position);
+            target_position = traj_update(&motor_trajectory);
+        }
+        else
+        {
+            traj_set_target(&motor_trajectory, target_speed);
+            target_speed = traj_update(&motor_trajectory);
+        }
+    }
+
+    switch (motor_control_mode)
+    {
+    case MOTOR_MODE_CASCADE:
+        Update_Motor_Position(target_position);
+        break;
+    case MOTOR_MODE_AUTOTUNE:
+        Update_Motor_Autotune();
+        break;
+    case MOTOR_MODE_STEP_TEST:
+        Update_Motor_Step_Test();
+        break;
+    case MOTOR_MODE_SCHEDULED:
+        Update_Motor_Speed_Scheduled(target_speed);
+        break;
+    case MOTOR_MODE_INCREMENTAL:
+        Update_Motor_Speed_Incremental(target_speed);
+        break;
+    case MOTOR_MODE_SPEED:
+    default:
+        Update_Motor_Speed(target_speed);
+        break;
+    }
+
+    // 串级模式的速度指令是位置环给出的速度设定值，开环的自整定和阶跃测试只检查明显的飞车
+    float command = target_speed;
+    if (motor_control_mode == MOTOR_MODE_CASCADE)
+    {
+        command = pid_cascade.speed_setpoint;
+    }
+    else if (motor_control_mode == MOTOR_MODE_AUTOTUNE ||
+             motor_control_mode == MOTOR_MODE_STEP_TEST)
+    {
+        command = FULL_SPEED_RPM;
+    }
+    Motor_Health_Check(command);
+
+    if (motor_control_mode != MOTOR_MODE_AUTOTUNE && motor_control_mode != MOTOR_MODE_STEP_TEST)
+    {
+        // Encoder_Motor_SetSpeed的speed为uint16，饱和时motor_output比满量程小不到1
+        uint8_t saturated = fabsf(motor_output) >= FULL_SPEED_RPM - 1.0f;
+        float measurement =
+            motor_control_mode == MOTOR_MODE_CASCADE ? Motor_Position_Degrees() : motor_speed;
+        pid_metrics_update(&motor_metrics, measurement, saturated);
+    }
+
+    // 其余注册的电机按各自的设定值运行速度闭环
+    Motor_Update_Secondary();
 
-    __HAL_TIM_SET_COUNTER(&htim3, 0);
+    // 统计本次中断的执行时间，用于估算CPU占用率
+    loop_timer_end(&motor_loop_timer);
 }
 
 // /**
@@ -0,0 +1,320 @@
+/**
+ * @file    encoder_motor.c
+ * @brief   编码器电机实例驱动实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件把单个编码器电机用到的硬件（PWM 定时器和通道、编码器定时器、方向引脚）
+ *          以及换算常数、位置、测速和速度环状态集中到 EncoderMotor 实例中，
+ *          同一套驱动可以服务多个电机（例如 TIM3 和 TIM4 各接一路编码器）。
+ *          注册后的电机由控制节拍统一采样、测速并运行各自的速度环，
+ *          编码器定时器的更新中断通过 encoder_motor_timer_update 分派到对应实例。
+ *          测速为 encoder_speed 中的定点管线：Q16 计数差 -> 按实测周期折算（无除法）
+ *          -> 可选的 Q31 滤波链 -> 定点一阶低通 -> 乘一次比例系数。
+ *          同步输出时比较值经预装载在 PWM 周期边界生效；需要切换方向引脚时，本周期先把比较值
+ *          置 0，在下一个周期边界（PWM 定时器更新中断）中切换引脚并写入新的比较值，
+ *          引脚只在输出为低的周期内变化，不会在 PWM 脉冲中间产生毛刺。
+ *
+ * @note    encoder.c 中的主电机（TIM1 CH1 + TIM3）同样是一个实例，其上的控制模式、
+ *          观测器和 M/T 测速等仍由 encoder.c 负责。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "encoder_motor.h"
+
+// 已注册的电机
+static EncoderMotor* encoder_motors[ENCODER_MOTOR_MAX];
+static uint8_t encoder_motors_registered = 0;
+
+/* 设置方向引脚电平 */
+static inline void encoder_motor_pins(EncoderMotor* motor, uint8_t ain1, uint8_t ain2)
+{
+    if (ain1)
+        motor->ain1_port->BSRR = motor->ain1_pin;
+    else
+        motor->ain1_port->BRR = motor->ain1_pin;
+    if (ain2)
+        motor->ain2_port->BSRR = motor->ain2_pin;
+    else
+        motor->ain2_port->BRR = motor->ain2_pin;
+    motor->ain1_state = ain1;
+    motor->ain2_state = ain2;
+}
+
+/* 输出方向引脚电平和比较值，同步输出时方向变化推迟到周期边界 */
+static void encoder_motor_output(EncoderMotor* motor, uint8_t ain1, uint8_t ain2,
+                                 uint32_t compare)
+{
+    // 未同步，或 PWM 定时器已停止（不会再有周期边界，等待中的切换永远不会生效）时直接切换
+    if (!motor->synchronized || !(motor->pwm_timer->Instance->CR1 & TIM_CR1_CEN))
+    {
+        if (motor->pending)
+        {
+            __HAL_TIM_DISABLE_IT(motor->pwm_timer, TIM_IT_UPDATE);
+            motor->pending = 0;
+        }
+        encoder_motor_pins(motor, ain1, ain2);
+        __HAL_TIM_SET_COMPARE(motor->pwm_timer, motor->pwm_channel, compare);
+        return;
+    }
+    if (motor->pending && ain1 == motor->pending_ain1 && ain2 == motor->pending_ain2)
+    {
+        // 与等待中的切换方向相同，只更新切换后的比较值
+        motor->pending_compare = compare;
+        return;
+    }
+    if (!motor->pending && ain1 == motor->ain1_state && ain2 == motor->ain2_state)
+    {
+        // 方向不变，预装载的比较值在下一个周期边界生效
+        __HAL_TIM_SET_COMPARE(motor->pwm_timer, motor->pwm_channel, compare);
+        return;
+    }
+    // 先置0再清除更新标志：即使清除前刚好经过周期边界，0也已生效，切换只是再晚一个周期
+    __HAL_TIM_DISABLE_IT(motor->pwm_timer, TIM_IT_UPDATE);
+    motor->pending_ain1    = ain1;
+    motor->pending_ain2    = ain2;
+    motor->pending_compare = compare;
+    motor->pending         = 1;
+    __HAL_TIM_SET_COMPARE(motor->pwm_timer, motor->pwm_channel, 0);
+    __HAL_TIM_CLEAR_IT(motor->pwm_timer, TIM_IT_UPDATE);
+    __HAL_TIM_ENABLE_IT(motor->pwm_timer, TIM_IT_UPDATE);
+}
+
+void encoder_motor_init(EncoderMotor* motor, TIM_HandleTypeDef* pwm_timer, uint32_t pwm_channel,
+                        TIM_HandleTypeDef* encoder_timer, GPIO_TypeDef* ain1_port,
+                        uint16_t ain1_pin, GPIO_TypeDef* ain2_port, uint16_t ain2_pin,
+                        float full_speed, float counts_to_speed)
+{
+    motor->pwm_timer       = pwm_timer;
+    motor->pwm_channel     = pwm_channel;
+    motor->encoder_timer   = encoder_timer;
+    motor->ain1_port       = ain1_port;
+    motor->ain1_pin        = ain1_pin;
+    motor->ain2_port       = ain2_port;
+    motor->ain2_pin        = ain2_pin;
+    motor->synchronized    = 0;
+    motor->ain1_state      = 0;
+    motor->ain2_state      = 0;
+    motor->pending         = 0;
+    motor->pending_ain1    = 0;
+    motor->pending_ain2    = 0;
+    motor->pending_compare = 0;
+    motor->full_speed      = full_speed;
+    motor->wraps           = 0;
+    motor->base            = 0;
+    motor->last            = 0;
+    motor->offset          = 0;
+    motor->position        = 0;
+    motor->pid             = NULL;
+    motor->setpoint        = 0.0f;
+    motor->output          = 0.0f;
+    encoder_speed_init(&motor->meter, counts_to_speed);
+}
+
+void encoder_motor_start(EncoderMotor* motor)
+{
+    // 定时器和方向引脚刚重新初始化，引脚为低电平，等待中的切换作废
+    motor->pending    = 0;
+    motor->ain1_state = 0;
+    motor->ain2_state = 0;
+    HAL_TIM_PWM_Start(motor->pwm_timer, motor->pwm_channel);
+    HAL_TIM_Encoder_Start(motor->encoder_timer, TIM_CHANNEL_1); // 开启编码器A
+    HAL_TIM_Encoder_Start(motor->encoder_timer, TIM_CHANNEL_2); // 开启编码器B
+    // 计数器上溢/下溢时进入更新中断维护回绕次数
+    motor->wraps = 0;
+    __HAL_TIM_CLEAR_IT(motor->encoder_timer, TIM_IT_UPDATE);
+    __HAL_TIM_ENABLE_IT(motor->encoder_timer, TIM_IT_UPDATE);
+    motor->last = encoder_motor_read(motor);
+}
+
+void encoder_motor_suspend(EncoderMotor* motor)
+{
+    // 重新初始化会把计数器清零，先把当前扩展位置存入base，位置不因重新初始化而丢失
+    __HAL_TIM_DISABLE_IT(motor->encoder_timer, TIM_IT_UPDATE);
+    motor->base = encoder_motor_read(motor);
+}
+
+void encoder_motor_set_synchronized(EncoderMotor* motor, uint8_t enable)
+{
+    __HAL_TIM_DISABLE_IT(motor->pwm_timer, TIM_IT_UPDATE);
+    if (motor->pending)
+    {
+        // 关闭同步输出时立即完成等待中的切换
+        encoder_motor_pwm_update(motor);
+    }
+    motor->synchronized = enable;
+}
+
+void encoder_motor_set_rate(EncoderMotor* motor, float fs)
+{
+    encoder_speed_set_rate(&motor->meter, fs, SystemCoreClock);
+}
+
+void encoder_motor_drive(EncoderMotor* motor, uint8_t mode, uint16_t speed)
+{
+    uint32_t full_scale = __HAL_TIM_GET_AUTORELOAD(motor->pwm_timer) + 1;
+    uint32_t compare    = (speed / motor->full_speed) * full_scale;
+    // 制动和停止不改变比较值
+    uint32_t current = __HAL_TIM_GET_COMPARE(motor->pwm_timer, motor->pwm_channel);
+    switch (mode)
+    {
+    case 0:
+        // 正向旋转
+        encoder_motor_output(motor, 0, 1, compare);
+        motor->output = speed;
+        break;
+    case 1:
+        // 反向旋转
+        encoder_motor_output(motor, 1, 0, compare);
+        motor->output = -(float)speed;
+        break;
+    case 2:
+        // 制动（两个方向引脚同为高电平）
+        encoder_motor_output(motor, 1, 1, current);
+        motor->output = 0.0f;
+        break;
+    case 3:
+        // 停止（两个方向引脚同为低电平）
+        encoder_motor_output(motor, 0, 0, current);
+        motor->output = 0.0f;
+        break;
+    default:
+        break;
+    }
+}
+
+void encoder_motor_apply(EncoderMotor* motor, float output)
+{
+    if (output >= 0)
+    {
+        encoder_motor_drive(motor, 0, (uint16_t)output);
+    }
+    else
+    {
+        encoder_motor_drive(motor, 1, (uint16_t)-output);
+    }
+}
+
+/* 编码器模式下计数器在两个方向都会回绕，进入中断时方向可能已经改变，因此不看DIR位，
+ * 而按计数值判断：回绕后计数器位于下半区说明是65535 -> 0的上溢，反之为下溢 */
+void encoder_motor_overflow(EncoderMotor* motor)
+{
+    if (__HAL_TIM_GET_COUNTER(motor->encoder_timer) < 0x8000)
+    {
+        motor->wraps++;
+    }
+    else
+    {
+        motor->wraps--;
+    }
+}
+
+void encoder_motor_pwm_update(EncoderMotor* motor)
+{
+    if (motor->pending)
+    {
+        // 本周期比较值为0，输出保持低电平，此时切换引脚；新的比较值在下一个周期边界生效
+        encoder_motor_pins(motor, motor->pending_ain1, motor->pending_ain2);
+        __HAL_TIM_SET_COMPARE(motor->pwm_timer, motor->pwm_channel, motor->pending_compare);
+        motor->pending = 0;
+    }
+    __HAL_TIM_DISABLE_IT(motor->pwm_timer, TIM_IT_UPDATE);
+}
+
+/* 回绕次数、更新标志和计数值不是同时读出的，读取期间被更新中断打断或刚好发生回绕时重读；
+ * 关中断时更新中断尚未处理的回绕按挂起标志修正 */
+int64_t encoder_motor_read(EncoderMotor* motor)
+{
+    TIM_HandleTypeDef* htim = motor->encoder_timer;
+    int32_t wraps;
+    uint32_t pending;
+    uint16_t counter;
+    do
+    {
+        wraps   = motor->wraps;
+        pending = __HAL_TIM_GET_FLAG(htim, TIM_FLAG_UPDATE);
+        counter = __HAL_TIM_GET_COUNTER(htim);
+    } while (wraps != motor->wraps || pending != __HAL_TIM_GET_FLAG(htim, TIM_FLAG_UPDATE));
+    if (pending)
+    {
+        wraps += counter < 0x8000 ? 1 : -1;
+    }
+    return motor->base + ((int64_t)wraps << 16) + counter;
+}
+
+void encoder_motor_zero(EncoderMotor* motor)
+{
+    __disable_irq();
+    motor->offset   = encoder_motor_read(motor);
+    motor->position = 0;
+    __enable_irq();
+}
+
+int32_t encoder_motor_sample(EncoderMotor* motor)
+{
+    int64_t position = encoder_motor_read(motor);
+    int32_t counts   = (int32_t)(position - motor->last);
+    motor->last      = position;
+    motor->position  = position - motor->offset;
+    return counts;
+}
+
+float encoder_motor_measure(EncoderMotor* motor, int32_t counts, uint32_t dt_cycles)
+{
+    return encoder_speed_measure(&motor->meter, counts, dt_cycles);
+}
+
+void encoder_motor_update(EncoderMotor* motor, uint32_t dt_cycles, float dt)
+{
+    int32_t counts = encoder_motor_sample(motor);
+    encoder_motor_measure(motor, counts, dt_cycles);
+    if (motor->pid != NULL)
+    {
+        encoder_motor_apply(motor,
+                            pid_update_dt(motor->pid, motor->setpoint, motor->meter.speed, dt));
+    }
+}
+
+int encoder_motor_register(EncoderMotor* motor)
+{
+    for (uint8_t i = 0; i < encoder_motors_registered; i++)
+    {
+        if (encoder_motors[i] == motor)
+        {
+            return i;
+        }
+    }
+    if (encoder_motors_registered >= ENCODER_MOTOR_MAX)
+    {
+        return -1;
+    }
+    encoder_motors[encoder_motors_registered] = motor;
+    return encoder_motors_registered++;
+}
+
+uint8_t encoder_motor_count()
+{
+    return encoder_motors_registered;
+}
+
+EncoderMotor* encoder_motor_get(uint8_t index)
+{
+    return index < encoder_motors_registered ? encoder_motors[index] : NULL;
+}
+
+void encoder_motor_timer_update(TIM_HandleTypeDef* htim)
+{
+    for (uint8_t i = 0; i < encoder_motors_registered; i++)
+    {
+        if (encoder_motors[i]->encoder_timer == htim)
+        {
+            encoder_motor_overflow(encoder_motors[i]);
+        }
+        else if (encoder_motors[i]->pwm_timer == htim)
+        {
+            encoder_motor_pwm_update(encoder_motors[i]);
+        }
+    }
+}
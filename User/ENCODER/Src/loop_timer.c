@@ -0,0 +1,110 @@
+/**
+ * @file    loop_timer.c
+ * @brief   控制周期测量实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件利用 Cortex-M3 的 DWT 周期计数器（CYCCNT）给每次控制中断打时间戳，
+ *          得到实际经过的采样间隔，供测速和 pid_update_dt 使用，
+ *          这样定时器分频、周期改变或中断被延后时，积分和微分仍按真实时间计算。
+ *          同时用 Welford 算法以 O(1) 的代价统计周期的均值、标准差和极值，
+ *          并在中断末尾再打一次时间戳，统计控制中断的执行时间和 CPU 占用率。
+ *
+ * @note    CYCCNT 为 32 位，72MHz 下约 59 秒回绕一次，无符号相减可正确处理回绕。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "loop_timer.h"
+#include <math.h>
+
+void loop_timer_init(LoopTimer* timer, float nominal)
+{
+    // 使能跟踪单元后才能使用 DWT 周期计数器
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    timer->nominal     = nominal;
+    timer->cycle_to_s  = 1.0f / SystemCoreClock;
+    timer->last_cycles = DWT->CYCCNT;
+    timer->samples     = 0;
+    timer->dt_cycles   = (uint32_t)(nominal * SystemCoreClock + 0.5f);
+    timer->dt          = nominal;
+    timer->dt_min      = nominal;
+    timer->dt_max      = nominal;
+    timer->dt_mean     = nominal;
+    timer->dt_m2       = 0.0f;
+    timer->jitter_max  = 0.0f;
+    timer->busy        = 0.0f;
+    timer->busy_max    = 0.0f;
+    timer->busy_mean   = 0.0f;
+}
+
+float loop_timer_sample(LoopTimer* timer)
+{
+    uint32_t now       = DWT->CYCCNT;
+    timer->dt_cycles   = now - timer->last_cycles;
+    float dt           = timer->dt_cycles * timer->cycle_to_s;
+    timer->last_cycles = now;
+    timer->dt          = dt;
+
+    // Welford 在线均值/方差
+    timer->samples++;
+    if (timer->samples == 1)
+    {
+        timer->dt_min  = dt;
+        timer->dt_max  = dt;
+        timer->dt_mean = dt;
+    }
+    else
+    {
+        float delta = dt - timer->dt_mean;
+        timer->dt_mean += delta / timer->samples;
+        timer->dt_m2 += delta * (dt - timer->dt_mean);
+        if (dt < timer->dt_min)
+            timer->dt_min = dt;
+        if (dt > timer->dt_max)
+            timer->dt_max = dt;
+    }
+
+    float jitter = fabsf(dt - timer->nominal);
+    if (jitter > timer->jitter_max)
+    {
+        timer->jitter_max = jitter;
+    }
+    return dt;
+}
+
+void loop_timer_end(LoopTimer* timer)
+{
+    if (timer->samples == 0)
+    {
+        return;
+    }
+    float busy  = (uint32_t)(DWT->CYCCNT - timer->last_cycles) * timer->cycle_to_s;
+    timer->busy = busy;
+    timer->busy_mean += (busy - timer->busy_mean) / timer->samples;
+    if (busy > timer->busy_max)
+    {
+        timer->busy_max = busy;
+    }
+}
+
+float loop_timer_jitter_rms(const LoopTimer* timer)
+{
+    if (timer->samples < 2)
+    {
+        return 0.0f;
+    }
+    return sqrtf(timer->dt_m2 / (timer->samples - 1));
+}
+
+float loop_timer_load(const LoopTimer* timer)
+{
+    if (timer->samples < 2 || timer->dt_mean <= 0.0f)
+    {
+        return 0.0f;
+    }
+    return timer->busy_mean / timer->dt_mean;
+}
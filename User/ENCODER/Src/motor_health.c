@@ -0,0 +1,141 @@
+/**
+ * @file    motor_health.c
+ * @brief   电机健康监测实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了编码器电机的故障检测。
+ *          每个控制节拍只做比较和加法，可以放在定时器中断里运行。
+ *          计数跳变：单拍计数差超过电机可能达到的最大值，立即判定（编码器受干扰等）。
+ *          堵转：|控制量| 持续不低于 stall_output 的 stall_ticks 拍内，
+ *              累计计数不超过 stall_counts。
+ *              按窗口累计而不是逐拍比较，控制频率很高、每拍只有零星计数时判据同样有效。
+ *          飞车：控制量与速度同号（仍在驱动而不是制动）时，|速度| 连续 runaway_ticks 拍
+ *              超过 |指令| * runaway_ratio + runaway_margin。
+ *          方向不符：控制量足够大时速度持续与控制量反号，且反向速度超过 direction_speed；
+ *              换向后的减速过程也会短暂反号，direction_ticks 需覆盖减速时间。
+ *          第一次检出的故障被锁存，之后不再更新，直到 motor_health_clear。
+ *
+ * @note    不依赖 HAL，切断输出由调用方根据返回值完成。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "motor_health.h"
+#include <math.h>
+#include <stdlib.h>
+
+// 故障码名称，顺序与MotorFault一致
+static char* motor_fault_names[MOTOR_FAULT_COUNT] = {"OK", "GLITCH", "STALL", "RUNAWAY", "DIR"};
+
+void motor_health_init(MotorHealth* health, float stall_output, int32_t stall_counts,
+                       float runaway_ratio, float runaway_margin, float direction_output,
+                       float direction_speed)
+{
+    health->stall_output     = stall_output;
+    health->stall_counts     = stall_counts;
+    health->runaway_ratio    = runaway_ratio;
+    health->runaway_margin   = runaway_margin;
+    health->direction_output = direction_output;
+    health->direction_speed  = direction_speed;
+    motor_health_set_timing(health, 0, 1, 1, 1);
+    motor_health_clear(health);
+}
+
+void motor_health_set_timing(MotorHealth* health, int32_t glitch_counts, uint16_t stall_ticks,
+                             uint16_t runaway_ticks, uint16_t direction_ticks)
+{
+    health->glitch_counts   = glitch_counts;
+    health->stall_ticks     = stall_ticks > 0 ? stall_ticks : 1;
+    health->runaway_ticks   = runaway_ticks > 0 ? runaway_ticks : 1;
+    health->direction_ticks = direction_ticks > 0 ? direction_ticks : 1;
+}
+
+void motor_health_clear(MotorHealth* health)
+{
+    health->stall_count     = 0;
+    health->stall_sum       = 0;
+    health->runaway_count   = 0;
+    health->direction_count = 0;
+    health->fault           = MOTOR_FAULT_NONE;
+    health->fault_value     = 0.0f;
+}
+
+/* 锁存故障 */
+static MotorFault motor_health_trip(MotorHealth* health, MotorFault fault, float value)
+{
+    health->fault       = fault;
+    health->fault_value = value;
+    return fault;
+}
+
+MotorFault motor_health_update(MotorHealth* health, float output, float command, float speed,
+                               int32_t counts)
+{
+    if (health->fault != MOTOR_FAULT_NONE)
+    {
+        return health->fault;
+    }
+
+    // glitch_counts为0时不检查计数跳变
+    if (health->glitch_counts > 0 && abs(counts) > health->glitch_counts)
+    {
+        return motor_health_trip(health, MOTOR_FAULT_GLITCH, counts);
+    }
+
+    // 堵转：大占空比期间按窗口累计计数，占空比降下来就重新开始
+    if (fabsf(output) >= health->stall_output)
+    {
+        health->stall_sum += counts;
+        if (++health->stall_count >= health->stall_ticks)
+        {
+            if (abs(health->stall_sum) <= health->stall_counts)
+            {
+                return motor_health_trip(health, MOTOR_FAULT_STALL, health->stall_sum);
+            }
+            health->stall_count = 0;
+            health->stall_sum   = 0;
+        }
+    }
+    else
+    {
+        health->stall_count = 0;
+        health->stall_sum   = 0;
+    }
+
+    // 飞车：控制量仍在沿转动方向驱动才计时，指令突降后正在减速的情况不算
+    if (output * speed > 0.0f &&
+        fabsf(speed) > fabsf(command) * health->runaway_ratio + health->runaway_margin)
+    {
+        if (++health->runaway_count >= health->runaway_ticks)
+        {
+            return motor_health_trip(health, MOTOR_FAULT_RUNAWAY, speed);
+        }
+    }
+    else
+    {
+        health->runaway_count = 0;
+    }
+
+    // 方向不符
+    if (fabsf(output) >= health->direction_output && output * speed < 0.0f &&
+        fabsf(speed) > health->direction_speed)
+    {
+        if (++health->direction_count >= health->direction_ticks)
+        {
+            return motor_health_trip(health, MOTOR_FAULT_DIRECTION, speed);
+        }
+    }
+    else
+    {
+        health->direction_count = 0;
+    }
+
+    return MOTOR_FAULT_NONE;
+}
+
+char* motor_health_fault_name(MotorFault fault)
+{
+    return fault < MOTOR_FAULT_COUNT ? motor_fault_names[fault] : "?";
+}
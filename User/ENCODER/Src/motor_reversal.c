@@ -0,0 +1,137 @@
+/**
+ * @file    motor_reversal.c
+ * @brief   电机换向状态机实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了 H 桥换向状态机的实现。
+ *          控制量过零时不直接翻转方向引脚，而是先进入 dwell_ticks 拍的制动或滑行，
+ *          等桥臂关断、电流衰减后再向另一方向起动，避免上下管直通和过零附近的来回抖动。
+ *          反向控制量必须超过 hysteresis 才换向，滞环内保持原方向并输出 0。
+ *          死区补偿把 |控制量| 从 [0, full_scale] 映射到 [deadband, full_scale]，
+ *          低于 hysteresis 的部分从 0 线性过渡到补偿后的值，补偿不会在零点附近产生跳变。
+ *
+ * @note    模式编号同 Encoder_Motor_SetSpeed：0 正转，1 反转，2 制动，3 滑行。不依赖 HAL。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "motor_reversal.h"
+
+void motor_reversal_init(MotorReversal* reversal, float full_scale, float hysteresis,
+                         float deadband, uint8_t dwell_mode, uint16_t dwell_ticks)
+{
+    reversal->full_scale  = full_scale;
+    reversal->hysteresis  = hysteresis > 0.0f ? hysteresis : 0.0f;
+    reversal->deadband    = deadband > 0.0f ? deadband : 0.0f;
+    reversal->dwell_mode  = dwell_mode == 2 ? 2 : 3;
+    reversal->state       = MOTOR_REVERSAL_STOPPED;
+    reversal->dwell_count = 0;
+    reversal->mode        = reversal->dwell_mode;
+    reversal->speed       = 0.0f;
+    motor_reversal_set_dwell(reversal, dwell_ticks);
+}
+
+void motor_reversal_set_dwell(MotorReversal* reversal, uint16_t dwell_ticks)
+{
+    reversal->dwell_ticks = dwell_ticks > 0 ? dwell_ticks : 1;
+    if (reversal->dwell_count > reversal->dwell_ticks)
+    {
+        reversal->dwell_count = reversal->dwell_ticks;
+    }
+}
+
+void motor_reversal_sync(MotorReversal* reversal, uint8_t mode)
+{
+    if (mode == 0)
+    {
+        reversal->state = MOTOR_REVERSAL_FORWARD;
+    }
+    else if (mode == 1)
+    {
+        reversal->state = MOTOR_REVERSAL_REVERSE;
+    }
+    else if (reversal->state != MOTOR_REVERSAL_DWELL)
+    {
+        reversal->state = MOTOR_REVERSAL_STOPPED;
+    }
+    reversal->mode = mode;
+}
+
+/* 死区补偿：magnitude 为当前方向上的控制量 */
+static float motor_reversal_compensate(const MotorReversal* reversal, float magnitude)
+{
+    if (magnitude <= 0.0f)
+    {
+        return 0.0f;
+    }
+    float slope = (reversal->full_scale - reversal->deadband) / reversal->full_scale;
+    if (magnitude < reversal->hysteresis)
+    {
+        // 滞环内从 0 线性过渡到滞环边界处的补偿值
+        return magnitude / reversal->hysteresis *
+               (reversal->deadband + reversal->hysteresis * slope);
+    }
+    float speed = reversal->deadband + magnitude * slope;
+    return speed < reversal->full_scale ? speed : reversal->full_scale;
+}
+
+uint8_t motor_reversal_update(MotorReversal* reversal, float output)
+{
+    switch (reversal->state)
+    {
+    case MOTOR_REVERSAL_FORWARD:
+        if (output < -reversal->hysteresis)
+        {
+            reversal->state       = MOTOR_REVERSAL_DWELL;
+            reversal->dwell_count = reversal->dwell_ticks;
+        }
+        break;
+    case MOTOR_REVERSAL_REVERSE:
+        if (output > reversal->hysteresis)
+        {
+            reversal->state       = MOTOR_REVERSAL_DWELL;
+            reversal->dwell_count = reversal->dwell_ticks;
+        }
+        break;
+    case MOTOR_REVERSAL_DWELL:
+        // 本拍是等待的第 dwell_ticks + 1 拍时桥臂已关断足够久，可以起动
+        if (reversal->dwell_count == 0 || --reversal->dwell_count == 0)
+        {
+            reversal->state = MOTOR_REVERSAL_STOPPED;
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (reversal->state == MOTOR_REVERSAL_STOPPED)
+    {
+        if (output > reversal->hysteresis)
+        {
+            reversal->state = MOTOR_REVERSAL_FORWARD;
+        }
+        else if (output < -reversal->hysteresis)
+        {
+            reversal->state = MOTOR_REVERSAL_REVERSE;
+        }
+    }
+
+    switch (reversal->state)
+    {
+    case MOTOR_REVERSAL_FORWARD:
+        reversal->mode  = 0;
+        reversal->speed = motor_reversal_compensate(reversal, output);
+        break;
+    case MOTOR_REVERSAL_REVERSE:
+        reversal->mode  = 1;
+        reversal->speed = motor_reversal_compensate(reversal, -output);
+        break;
+    default:
+        reversal->mode  = reversal->dwell_mode;
+        reversal->speed = 0.0f;
+        break;
+    }
+    return reversal->mode;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file    mt_speed.c
+ * @brief   M/T 法测速实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了 M/T 法测速的实现。
+ *          M 法：速度 = 采样周期内的计数差 / 采样周期，低速时一个周期只有几个计数，分辨率很差。
+ *          T 法（M/T）：捕获中断给每个编码器边沿记录计数器值和时间戳，采样时取
+ *              速度 = (本窗口最后一个边沿 - 上一窗口最后一个边沿) 的计数差 / 两边沿的时间差，
+ *          分子是整数个边沿、分母是精确时间，分辨率只取决于时间戳的精度，与采样周期无关。
+ *          窗口内没有边沿时，速度的绝对值不会超过“一个边沿间隔 / 距上个边沿的时间”，
+ *          据此让速度随停转平滑衰减到 0。
+ *          高速时每秒的捕获中断数随速度线性增加，超过 switch_high 后切到 M 法，
+ *          由调用方关闭捕获中断；低于 switch_low 时切回 T 法。
+ *
+ * @note    edge_* 由捕获中断写、采样节拍读，捕获中断的优先级须高于采样中断。
+ *          计数差按补码相减，跨 16 位计数器回绕也正确。不依赖 HAL。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "mt_speed.h"
+#include <math.h>
+
+void mt_speed_init(MTSpeed* mt, float cycle_to_s, float counts_per_edge, float switch_high,
+                   float switch_low)
+{
+    mt->cycle_to_s      = cycle_to_s;
+    mt->counts_per_edge = counts_per_edge;
+    mt->switch_high     = switch_high;
+    mt->switch_low      = switch_low < switch_high ? switch_low : switch_high;
+    mt->edges           = 0;
+    mt_speed_reset(mt, 0, 0);
+}
+
+void mt_speed_reset(MTSpeed* mt, uint16_t count, uint32_t now)
+{
+    mt->prev_count  = count;
+    mt->prev_cycles = now;
+    mt->prev_edges  = mt->edges;
+    mt->edge_valid  = 0;
+    mt->t_method    = 1;
+    mt->speed       = 0.0f;
+}
+
+void mt_speed_capture(MTSpeed* mt, uint16_t count, uint32_t cycles)
+{
+    mt->edge_count  = count;
+    mt->edge_cycles = cycles;
+    mt->edges++;
+}
+
+/* T 法：用窗口内的边沿计算速度，没有新边沿时按距上个边沿的时间限制速度 */
+static float mt_speed_t_method(MTSpeed* mt, float m_speed, uint32_t now)
+{
+    // 读取期间若被捕获中断打断，edges 会变化，重读保证三个量属于同一个边沿
+    uint32_t edges;
+    uint16_t edge_count;
+    uint32_t edge_cycles;
+    do
+    {
+        edges       = mt->edges;
+        edge_count  = mt->edge_count;
+        edge_cycles = mt->edge_cycles;
+    } while (edges != mt->edges);
+
+    if (edges == mt->prev_edges)
+    {
+        if (!mt->edge_valid)
+        {
+            return m_speed;
+        }
+        float since_edge = (uint32_t)(now - mt->prev_edge_cycles) * mt->cycle_to_s;
+        float bound      = mt->counts_per_edge / since_edge;
+        if (fabsf(mt->speed) > bound)
+        {
+            return mt->speed > 0.0f ? bound : -bound;
+        }
+        return mt->speed;
+    }
+
+    float speed = m_speed;
+    if (mt->edge_valid)
+    {
+        int16_t edge_counts = (int16_t)(edge_count - mt->prev_edge_count);
+        float edge_dt       = (uint32_t)(edge_cycles - mt->prev_edge_cycles) * mt->cycle_to_s;
+        if (edge_dt > 0.0f)
+        {
+            speed = edge_counts / edge_dt;
+        }
+    }
+    mt->prev_edge_count  = edge_count;
+    mt->prev_edge_cycles = edge_cycles;
+    mt->prev_edges       = edges;
+    mt->edge_valid       = 1;
+    return speed;
+}
+
+float mt_speed_update(MTSpeed* mt, uint16_t count, uint32_t now)
+{
+    int16_t counts  = (int16_t)(count - mt->prev_count);
+    float dt        = (uint32_t)(now - mt->prev_cycles) * mt->cycle_to_s;
+    mt->prev_count  = count;
+    mt->prev_cycles = now;
+    if (dt <= 0.0f)
+    {
+        return mt->speed;
+    }
+
+    float speed = counts / dt;
+    if (mt->t_method)
+    {
+        speed = mt_speed_t_method(mt, speed, now);
+    }
+
+    // 按速度在 M 法和 T 法之间切换，切回 T 法后的第一个边沿只作为起点
+    float magnitude = fabsf(speed);
+    if (mt->t_method && magnitude > mt->switch_high)
+    {
+        mt->t_method = 0;
+    }
+    else if (!mt->t_method && magnitude < mt->switch_low)
+    {
+        mt->t_method   = 1;
+        mt->edge_valid = 0;
+        mt->prev_edges = mt->edges;
+    }
+    mt->speed = speed;
+    return speed;
+}
@@ -0,0 +1,66 @@
+#ifndef __BIQUAD_H
+#define __BIQUAD_H
+
+#include <stdint.h>
+
+// 每条级联链的最大二阶节数
+#define BIQUAD_MAX_SECTIONS 4
+// Q31 版本系数的小数位数（Q2.29，可表示 [-4, 4)）
+#define BIQUAD_Q29_SHIFT 29
+
+typedef int32_t q31_t;
+
+// 二阶节（直接 II 型转置），系数已按 a0 归一化：
+// H(z) = (b0 + b1·z⁻¹ + b2·z⁻²) / (1 + a1·z⁻¹ + a2·z⁻²)
+typedef struct
+{
+    float b0, b1, b2;
+    float a1, a2;
+    float s1, s2; // 转置结构的两个状态
+} BiquadSection;
+
+// 级联二阶节滤波器（浮点）
+typedef struct
+{
+    BiquadSection sections[BIQUAD_MAX_SECTIONS];
+    uint8_t count; // 已启用的节数，为 0 时直通
+} BiquadChain;
+
+// Q31 二阶节：系数为 Q2.29，状态为 64 位（Q31 × Q29 = Q60）
+typedef struct
+{
+    int32_t b0, b1, b2;
+    int32_t a1, a2;
+    int64_t s1, s2;
+} BiquadSectionQ31;
+
+// 级联二阶节滤波器（Q31），输入输出为 Q31，建议信号留出 6dB 余量
+typedef struct
+{
+    BiquadSectionQ31 sections[BIQUAD_MAX_SECTIONS];
+    uint8_t count;
+} BiquadChainQ31;
+
+void biquad_chain_init(BiquadChain* chain);
+// 追加一节并返回指向它的指针，已满时返回 NULL；新节默认直通，再用下面的设计函数配置
+BiquadSection* biquad_chain_add(BiquadChain* chain);
+// 把所有状态置为输入恒为 value 时的稳态，启用滤波时输出不跳变
+void biquad_chain_reset(BiquadChain* chain, float value);
+float biquad_chain_process(BiquadChain* chain, float input);
+
+// 运行中重新设计某一节（只改系数，保留状态）
+void biquad_set_coefficients(BiquadSection* section, float b0, float b1, float b2, float a1,
+                             float a2);
+// 二阶低通：截止频率 fc（Hz），品质因数 Q（0.707 为巴特沃斯），采样频率 fs（Hz）
+void biquad_set_lowpass(BiquadSection* section, float fc, float Q, float fs);
+// 陷波：中心频率 f0（Hz），Q 越大陷波越窄、对低频相位影响越小
+void biquad_set_notch(BiquadSection* section, float f0, float Q, float fs);
+// 一阶超前/滞后：H(s) = (s/ωz + 1) / (s/ωp + 1)，直流增益为 1；f_zero < f_pole 为超前
+void biquad_set_lead_lag(BiquadSection* section, float f_zero, float f_pole, float fs);
+
+// 由浮点滤波器的系数生成 Q31 滤波器（状态清零）
+void biquad_chain_q31_from_float(BiquadChainQ31* chain_q31, const BiquadChain* chain);
+void biquad_chain_q31_reset(BiquadChainQ31* chain);
+q31_t biquad_chain_q31_process(BiquadChainQ31* chain, q31_t input);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef __SPEED_OBSERVER_H
+#define __SPEED_OBSERVER_H
+
+#include <stdint.h>
+
+// 定点格式：位置和速度均为 Q16.16（单位：编码器计数、计数/节拍）
+#define SPEED_OBSERVER_Q 16
+
+// 编码器位置/速度观测器（匀速模型），α-β 和稳态卡尔曼共用同一个定点更新
+typedef struct
+{
+    int32_t position; // 位置估计，Q16.16 计数，与 16 位编码器计数器一样按 2^16 计数回绕
+    int32_t velocity; // 速度估计，Q16.16 计数/节拍
+    int32_t alpha;    // 位置修正增益，Q16
+    int32_t beta;     // 速度修正增益，Q16
+} SpeedObserver;
+
+// α-β 观测器：alpha 取 (0, 1]，beta 取 (0, 2]，临界阻尼时 beta = alpha² / (2 - alpha)
+void speed_observer_init_alpha_beta(SpeedObserver* observer, float alpha, float beta);
+// 二状态卡尔曼观测器：按过程噪声（加速度标准差，计数/节拍²）和测量噪声（计数）
+// 迭代 Riccati 方程求出稳态卡尔曼增益，运行时与 α-β 一样只做定点乘加
+void speed_observer_init_kalman(SpeedObserver* observer, float accel_noise, float meas_noise);
+// 以当前计数值为初始位置、速度清零
+void speed_observer_reset(SpeedObserver* observer, uint16_t count);
+// 每个采样节拍调用一次，count 为编码器计数器的原始值（可回绕）
+void speed_observer_update(SpeedObserver* observer, uint16_t count);
+// 速度估计（计数/节拍）
+float speed_observer_velocity(const SpeedObserver* observer);
+
+#endif
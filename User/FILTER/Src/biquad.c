@@ -0,0 +1,165 @@
+/**
+ * @file    biquad.c
+ * @brief   级联二阶节（biquad）滤波器实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了直接 II 型转置（DF2T）级联二阶节滤波器的浮点和 Q31 实现，
+ *          以及低通、陷波、一阶超前/滞后三种节的设计函数（RBJ 公式 / 双线性变换）。
+ *          DF2T 每节只有两个状态，浮点下数值特性好；Q31 版本用 64 位状态累加，
+ *          适合无 FPU 的定点管线。
+ *          典型用法：测速信号上加陷波滤除齿轮箱共振，PID 输出上加低通或陷波后再送 PWM，
+ *          陷波只在中心频率附近衰减，对穿越频率处的相位滞后很小。
+ *
+ * @note    设计函数含三角函数，只应在初始化或参数修改时调用；process 只有乘加。不依赖 HAL。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "biquad.h"
+#include <math.h>
+#include <stddef.h>
+
+#define BIQUAD_PI 3.14159265f
+
+void biquad_chain_init(BiquadChain* chain)
+{
+    chain->count = 0;
+}
+
+BiquadSection* biquad_chain_add(BiquadChain* chain)
+{
+    if (chain->count >= BIQUAD_MAX_SECTIONS)
+    {
+        return NULL;
+    }
+    BiquadSection* section = &chain->sections[chain->count++];
+    biquad_set_coefficients(section, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+    section->s1 = 0.0f;
+    section->s2 = 0.0f;
+    return section;
+}
+
+void biquad_chain_reset(BiquadChain* chain, float value)
+{
+    for (uint8_t i = 0; i < chain->count; i++)
+    {
+        BiquadSection* s = &chain->sections[i];
+        // 稳态时 y = H(1)·x，由 s2 = b2·x - a2·y、s1 = b1·x - a1·y + s2 倒推状态
+        float den    = 1.0f + s->a1 + s->a2;
+        float output = den != 0.0f ? value * (s->b0 + s->b1 + s->b2) / den : 0.0f;
+        s->s2        = s->b2 * value - s->a2 * output;
+        s->s1        = s->b1 * value - s->a1 * output + s->s2;
+        value        = output;
+    }
+}
+
+float biquad_chain_process(BiquadChain* chain, float input)
+{
+    for (uint8_t i = 0; i < chain->count; i++)
+    {
+        BiquadSection* s = &chain->sections[i];
+        float output     = s->b0 * input + s->s1;
+        s->s1            = s->b1 * input - s->a1 * output + s->s2;
+        s->s2            = s->b2 * input - s->a2 * output;
+        input            = output;
+    }
+    return input;
+}
+
+void biquad_set_coefficients(BiquadSection* section, float b0, float b1, float b2, float a1,
+                             float a2)
+{
+    section->b0 = b0;
+    section->b1 = b1;
+    section->b2 = b2;
+    section->a1 = a1;
+    section->a2 = a2;
+}
+
+void biquad_set_lowpass(BiquadSection* section, float fc, float Q, float fs)
+{
+    float w0    = 2.0f * BIQUAD_PI * fc / fs;
+    float cosw  = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * Q);
+    float inv   = 1.0f / (1.0f + alpha);
+    biquad_set_coefficients(section, 0.5f * (1.0f - cosw) * inv, (1.0f - cosw) * inv,
+                            0.5f * (1.0f - cosw) * inv, -2.0f * cosw * inv, (1.0f - alpha) * inv);
+}
+
+void biquad_set_notch(BiquadSection* section, float f0, float Q, float fs)
+{
+    float w0    = 2.0f * BIQUAD_PI * f0 / fs;
+    float cosw  = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * Q);
+    float inv   = 1.0f / (1.0f + alpha);
+    biquad_set_coefficients(section, inv, -2.0f * cosw * inv, inv, -2.0f * cosw * inv,
+                            (1.0f - alpha) * inv);
+}
+
+void biquad_set_lead_lag(BiquadSection* section, float f_zero, float f_pole, float fs)
+{
+    // 双线性变换 s = K·(1 - z⁻¹)/(1 + z⁻¹)，K = 2·fs
+    float K   = 2.0f * fs;
+    float kz  = K / (2.0f * BIQUAD_PI * f_zero);
+    float kp  = K / (2.0f * BIQUAD_PI * f_pole);
+    float inv = 1.0f / (kp + 1.0f);
+    biquad_set_coefficients(section, (kz + 1.0f) * inv, (1.0f - kz) * inv, 0.0f,
+                            (1.0f - kp) * inv, 0.0f);
+}
+
+/* 浮点系数 -> Q2.29，超出范围时饱和 */
+static int32_t biquad_coefficient_q29(float c)
+{
+    float scaled = c * (float)(1L << BIQUAD_Q29_SHIFT);
+    if (scaled >= 2147483647.0f)
+        return INT32_MAX;
+    if (scaled <= -2147483648.0f)
+        return INT32_MIN;
+    return (int32_t)lrintf(scaled);
+}
+
+void biquad_chain_q31_from_float(BiquadChainQ31* chain_q31, const BiquadChain* chain)
+{
+    chain_q31->count = chain->count;
+    for (uint8_t i = 0; i < chain->count; i++)
+    {
+        const BiquadSection* s = &chain->sections[i];
+        BiquadSectionQ31* q    = &chain_q31->sections[i];
+        q->b0                  = biquad_coefficient_q29(s->b0);
+        q->b1                  = biquad_coefficient_q29(s->b1);
+        q->b2                  = biquad_coefficient_q29(s->b2);
+        q->a1                  = biquad_coefficient_q29(s->a1);
+        q->a2                  = biquad_coefficient_q29(s->a2);
+    }
+    biquad_chain_q31_reset(chain_q31);
+}
+
+void biquad_chain_q31_reset(BiquadChainQ31* chain)
+{
+    for (uint8_t i = 0; i < chain->count; i++)
+    {
+        chain->sections[i].s1 = 0;
+        chain->sections[i].s2 = 0;
+    }
+}
+
+q31_t biquad_chain_q31_process(BiquadChainQ31* chain, q31_t input)
+{
+    for (uint8_t i = 0; i < chain->count; i++)
+    {
+        BiquadSectionQ31* s = &chain->sections[i];
+        // 状态保持 Q60 精度，只在输出时移回 Q31 并饱和
+        int64_t acc = (int64_t)s->b0 * input + s->s1;
+        int64_t out = acc >> BIQUAD_Q29_SHIFT;
+        if (out > INT32_MAX)
+            out = INT32_MAX;
+        if (out < INT32_MIN)
+            out = INT32_MIN;
+        s->s1 = (int64_t)s->b1 * input - (int64_t)s->a1 * out + s->s2;
+        s->s2 = (int64_t)s->b2 * input - (int64_t)s->a2 * out;
+        input = (q31_t)out;
+    }
+    return input;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file    speed_observer.c
+ * @brief   编码器位置/速度观测器实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了基于匀速模型的位置/速度观测器，直接以编码器原始计数为测量：
+ *              预测：x⁻ = x + v，v⁻ = v（单位为计数/节拍，省去与 Ts 的乘法）
+ *              修正：r = z - x⁻，x = x⁻ + α·r，v = v⁻ + β·r
+ *          α-β 观测器由用户直接给定增益；卡尔曼观测器在初始化时用浮点迭代 Riccati 方程
+ *          求出稳态增益，之后与 α-β 共用同一个 Q16.16 定点更新，中断中没有浮点运算。
+ *          与“计数差 + 一阶低通”相比，观测器在速度变化时没有固定的滤波滞后，
+ *          对单个计数的量化跳变又有平滑作用。
+ *
+ * @note    位置按 2^16 计数回绕，与 16 位编码器计数器一致，新息按补码相减即可跨回绕。
+ *          不依赖 HAL。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "speed_observer.h"
+
+// 稳态卡尔曼增益的 Riccati 迭代次数
+#define SPEED_OBSERVER_RICCATI_ITERATIONS 200
+
+/* 浮点增益 -> Q16，限制在 [0, max] */
+static int32_t speed_observer_gain_q16(float gain, float max)
+{
+    if (gain < 0.0f)
+        gain = 0.0f;
+    if (gain > max)
+        gain = max;
+    return (int32_t)(gain * (1L << SPEED_OBSERVER_Q) + 0.5f);
+}
+
+void speed_observer_init_alpha_beta(SpeedObserver* observer, float alpha, float beta)
+{
+    observer->alpha = speed_observer_gain_q16(alpha, 1.0f);
+    observer->beta  = speed_observer_gain_q16(beta, 2.0f);
+    speed_observer_reset(observer, 0);
+}
+
+void speed_observer_init_kalman(SpeedObserver* observer, float accel_noise, float meas_noise)
+{
+    // 匀速模型 F = [1 1; 0 1]，H = [1 0]，离散白噪声加速度 Q = q·[1/4 1/2; 1/2 1]
+    float q   = accel_noise * accel_noise;
+    float r   = meas_noise * meas_noise;
+    float p00 = r, p01 = 0.0f, p11 = r;
+    float k0 = 1.0f, k1 = 0.0f;
+    for (uint16_t i = 0; i < SPEED_OBSERVER_RICCATI_ITERATIONS; i++)
+    {
+        // 预测 P⁻ = F·P·Fᵀ + Q
+        float m00 = p00 + 2.0f * p01 + p11 + 0.25f * q;
+        float m01 = p01 + p11 + 0.5f * q;
+        float m11 = p11 + q;
+        // 增益 K = P⁻·Hᵀ / (H·P⁻·Hᵀ + R)，修正 P = (I - K·H)·P⁻
+        float s = m00 + r;
+        k0      = m00 / s;
+        k1      = m01 / s;
+        p00     = (1.0f - k0) * m00;
+        p01     = (1.0f - k0) * m01;
+        p11     = m11 - k1 * m01;
+    }
+    // 过程噪声大时 k1 超过 1（上限为 2），按 1 截断会偏离稳态卡尔曼解
+    observer->alpha = speed_observer_gain_q16(k0, 1.0f);
+    observer->beta  = speed_observer_gain_q16(k1, 2.0f);
+    speed_observer_reset(observer, 0);
+}
+
+void speed_observer_reset(SpeedObserver* observer, uint16_t count)
+{
+    observer->position = (int32_t)((uint32_t)count << SPEED_OBSERVER_Q);
+    observer->velocity = 0;
+}
+
+void speed_observer_update(SpeedObserver* observer, uint16_t count)
+{
+    // 以无符号运算实现按 2^32 回绕（即按 2^16 计数回绕），避免有符号溢出
+    uint32_t predicted  = (uint32_t)observer->position + (uint32_t)observer->velocity;
+    uint32_t measured   = (uint32_t)count << SPEED_OBSERVER_Q;
+    int32_t innovation  = (int32_t)(measured - predicted);
+    int32_t pos_correct = (int32_t)(((int64_t)innovation * observer->alpha) >> SPEED_OBSERVER_Q);
+    int32_t vel_correct = (int32_t)(((int64_t)innovation * observer->beta) >> SPEED_OBSERVER_Q);
+    observer->position  = (int32_t)(predicted + (uint32_t)pos_correct);
+    observer->velocity += vel_correct;
+}
+
+float speed_observer_velocity(const SpeedObserver* observer)
+{
+    return observer->velocity * (1.0f / (1L << SPEED_OBSERVER_Q));
+}
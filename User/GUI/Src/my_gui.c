@@ -132,6 +132,25 @@ int text_led()
     }
 }
 
+/**
+ * @brief 检查电机健康监测，新锁存的故障通过串口报告一次
+ * @return 当前锁存的故障码
+ */
+static MotorFault motor_fault_poll()
+{
+    static MotorFault reported = MOTOR_FAULT_NONE;
+    MotorFault fault           = Motor_Fault();
+    if (fault != reported)
+    {
+        reported = fault;
+        if (fault != MOTOR_FAULT_NONE)
+        {
+            printf("FAULT %s %.2f\r\n", motor_health_fault_name(fault), motor_health.fault_value);
+        }
+    }
+    return fault;
+}
+
 /**
  * @brief 显示电机速度文本并处理按钮输入以控制电机方向和速度
  * @param 无参数
@@ -164,6 +183,12 @@ int text_motor()
         {
             Encoder_Motor_SetSpeed(3, 0); // 停止电机
         }
+        if (motor_fault_poll() != MOTOR_FAULT_NONE) // 健康监测已切断输出，显示故障码
+        {
+            OLED_PrintASCIIString(0, 56, "FAULT:", &afont8x6, OLED_COLOR_NORMAL);
+            OLED_PrintASCIIString(36, 56, motor_health_fault_name(Motor_Fault()), &afont8x6,
+                                  OLED_COLOR_NORMAL);
+        }
 
         if (button_status == BUTTON_SET) // 检测设置按钮
         {
@@ -174,6 +199,7 @@ int text_motor()
         {
             button_status = 0;                       // 重置按钮状态
             HAL_TIM_PWM_Stop(&htim1, TIM_CHANNEL_1); // 停止PWM定时器
+            Encoder_Motor_SetSpeed(3, 0);            // 桥臂滑行（PWM已停止，方向引脚立即切换）
             READ_SPEED = 0;                          // 清除读取速度标志
             return 0;                                // 返回0表示重置
         }
@@ -900,12 +926,53 @@ float pid_ts(float ts)
     }
 }
 
+/**
+ * @brief 通过串口输出当前回路的控制性能指标
+ */
+static void pid_metrics_report()
+{
+    printf("METRICS IAE=%.3f ISE=%.3f ITAE=%.3f OS=%.2f%% TR=%.2fs TS=%.2fs SAT=%.1f%%\r\n",
+           motor_metrics.iae, motor_metrics.ise, motor_metrics.itae,
+           pid_metrics_overshoot(&motor_metrics), pid_metrics_rise_time(&motor_metrics),
+           pid_metrics_settling_time(&motor_metrics), pid_metrics_saturation_duty(&motor_metrics));
+    printf("RLS a=%.4f b=%.4f conf=%.2f err=%.3e\r\n", motor_rls.a, motor_rls.b,
+           pid_rls_confidence(&motor_rls), motor_rls.error_var);
+}
+
+/**
+ * @brief 在OLED上显示当前回路的控制性能指标页
+ */
+static void pid_metrics_page()
+{
+    char str[24];
+
+    OLED_NewFrame();
+    OLED_PrintString(0, 0, "METRICS", &font16x16, OLED_COLOR_NORMAL);
+    sprintf(str, "IAE:%.4g ISE:%.4g", motor_metrics.iae, motor_metrics.ise);
+    OLED_PrintASCIIString(0, 24, str, &afont8x6, OLED_COLOR_NORMAL);
+    sprintf(str, "ITAE:%.4g", motor_metrics.itae);
+    OLED_PrintASCIIString(0, 32, str, &afont8x6, OLED_COLOR_NORMAL);
+    sprintf(str, "OS:%.1f%% TR:%.2fs", pid_metrics_overshoot(&motor_metrics),
+            pid_metrics_rise_time(&motor_metrics));
+    OLED_PrintASCIIString(0, 40, str, &afont8x6, OLED_COLOR_NORMAL);
+    sprintf(str, "TS:%.2fs SAT:%.0f%%", pid_metrics_settling_time(&motor_metrics),
+            pid_metrics_saturation_duty(&motor_metrics));
+    OLED_PrintASCIIString(0, 48, str, &afont8x6, OLED_COLOR_NORMAL);
+    // 在线辨识得到的对象模型和置信度
+    float K = 0.0f, tau = 0.0f;
+    pid_rls_model(&motor_rls, &K, &tau);
+    sprintf(str, "K:%.2f T:%.2fs C:%.0f%%", K, tau, 100.0f * pid_rls_confidence(&motor_rls));
+    OLED_PrintASCIIString(0, 56, str, &afont8x6, OLED_COLOR_NORMAL);
+    OLED_ShowFrame();
+}
+
 /**
  * @brief 运行PID控制器并处理按钮输入以控制电机速度
  * @param kp 比例系数
  * @param ki 积分系数
  * @param kd 微分系数
- * @param ts 目标速度
+ * 左右按钮在曲线页和性能指标页之间切换，进入指标页和退出时通过串口输出指标。
+ * @param ts 目标速度（串级模式下为目标位置，单位度）
  * @param T 采样时间
  * @param out_min 输出最小值
  * @param out_max 输出最大值
@@ -915,17 +982,57 @@ void pid_run(float kp, float ki, float kd, float ts, float T, float out_min, flo
              float tau)
 {
     int show_x = 0, ts_y = 0, vs_y = 0, show_flag = 0;
-    extern PIDController pid;  // 声明外部PID控制器结构体
-    extern float target_speed; // 声明外部目标速度变量
-    extern float motor_speed;  // 声明外部电机速度变量
-    extern uint8_t READ_SPEED; // 声明外部读取速度标志变量
-
-    target_speed = ts;    // 设置目标速度为传入的ts值
-    READ_SPEED   = 0;     // 重置读取速度标志
-    Encoder_Motor_Init(); // 初始化编码器和电机
+    uint8_t metrics_page = 0; // 是否显示性能指标页
+    extern PIDController pid;     // 声明外部PID控制器结构体
+    extern float target_speed;    // 声明外部目标速度变量
+    extern float target_position; // 声明外部目标位置变量
+    extern float motor_speed;     // 声明外部电机速度变量
+    extern uint8_t READ_SPEED;    // 声明外部读取速度标志变量
+
+    float target_value = ts, actual_value = 0.0f; // 曲线显示的目标值和实际值
+    float scale_max = out_max, scale_min = out_min; // 曲线显示的纵轴范围
+
+    READ_SPEED = 0; // 重置读取速度标志
+    if (motor_control_mode == MOTOR_MODE_CASCADE)
+    {
+        // 串级模式：ts为目标位置（度），纵轴按目标位置缩放
+        target_position = ts;
+        Motor_Position_Zero();
+        scale_max = fabsf(ts) > 1.0f ? fabsf(ts) : 360.0f;
+        scale_min = -scale_max;
+    }
+    else
+    {
+        target_speed = ts; // 设置目标速度为传入的ts值
+    }
 
-    // 初始化PID控制器参数
-    pid_init(&pid, kp, ki, kd, T, out_min, out_max, tau);
+    // 初始化PID控制器参数（在TIM2中断使能前完成）
+    if (motor_control_mode == MOTOR_MODE_CASCADE)
+    {
+        // 内环（速度环）使用界面参数，外环（位置环）使用默认参数，输出为速度设定值
+        pid_init(&pid, kp, ki, kd, T * SPEED_LOOP_DIVIDER, out_min, out_max, tau);
+        pid_init(&pid_position, POSITION_KP, POSITION_KI, POSITION_KD, T * POSITION_LOOP_DIVIDER,
+                 -FULL_SPEED_RPM, FULL_SPEED_RPM, 0.0f);
+    }
+    else if (motor_control_mode == MOTOR_MODE_INCREMENTAL)
+    {
+        // 增量式PID从电机的实际控制量开始累加：Encoder_Motor_Init重新初始化方向引脚，
+        // 桥臂处于滑行状态，实际控制量为0（此时的motor_output是上次运行留下的值）
+        pid_velocity_init(&pid_incremental, kp, ki, kd, T, out_min, out_max, tau);
+        pid_velocity_track(&pid_incremental, 0.0f, ts, motor_speed);
+    }
+    else
+    {
+        pid_init(&pid, kp, ki, kd, T, out_min, out_max, tau);
+        // 速度环使用设定值加权，减小目标速度阶跃时的比例冲击（前馈负责大部分控制量）
+        pid_set_setpoint_weights(&pid, SPEED_SETPOINT_WEIGHT_B, SPEED_SETPOINT_WEIGHT_C);
+    }
+    if (motor_trajectory_enabled)
+    {
+        Motor_Trajectory_Start(T); // 目标值按S曲线轨迹逐步逼近ts
+    }
+    Motor_Metrics_Start(ts, T);
+    Encoder_Motor_Init(); // 初始化编码器和电机（串级控制器在其中复位）
 
     // 清除OLED屏幕并绘制初始线条
     OLED_NewFrame();
@@ -937,9 +1044,25 @@ void pid_run(float kp, float ki, float kd, float ts, float T, float out_min, flo
 
     while (1)
     {
-        // 将目标速度和电机速度转换为字符串格式
-        sprintf(str_ts, "%.2f", target_speed);
-        sprintf(str_vs, "%.2f", motor_speed);
+        // 串级模式显示位置，速度模式显示速度
+        if (motor_control_mode == MOTOR_MODE_CASCADE)
+        {
+            actual_value = Motor_Position_Degrees();
+        }
+        else
+        {
+            actual_value = motor_speed;
+        }
+        // 启用S曲线轨迹时目标曲线显示轨迹当前的设定值
+        if (motor_trajectory_enabled)
+        {
+            target_value = motor_control_mode == MOTOR_MODE_CASCADE ? motor_trajectory.pos
+                                                                    : motor_trajectory.vel;
+        }
+
+        // 将目标值和实际值转换为字符串格式
+        sprintf(str_ts, "%.2f", target_value);
+        sprintf(str_vs, "%.2f", actual_value);
 
         // 如果重置按钮被按下
         if (button_status == BUTTON_RST)
@@ -947,6 +1070,20 @@ void pid_run(float kp, float ki, float kd, float ts, float T, float out_min, flo
             HAL_TIM_Base_Stop_IT(&htim2);            // 停止TIM2的中断
             pid_reset(&pid);                         // 重置PID控制器
             HAL_TIM_PWM_Stop(&htim1, TIM_CHANNEL_1); // 停止TIM1的PWM模式通道1
+            Encoder_Motor_SetSpeed(3, 0);            // 桥臂滑行（PWM已停止，方向引脚立即切换）
+
+            pid_cascade_reset(&pid_cascade);         // 重置串级控制器
+
+            // 打印本次运行的控制周期统计（秒）
+            printf("dt mean %.5f min %.5f max %.5f rms %.6f jitter %.6f\r\n",
+                   motor_loop_timer.dt_mean, motor_loop_timer.dt_min, motor_loop_timer.dt_max,
+                   loop_timer_jitter_rms(&motor_loop_timer), motor_loop_timer.jitter_max);
+            printf("rate %.1fHz busy mean %.6f max %.6f load %.1f%%\r\n", Motor_Control_Rate(),
+                   motor_loop_timer.busy_mean, motor_loop_timer.busy_max,
+                   100.0f * Motor_Control_Load());
+            printf("health %s %.2f\r\n", motor_health_fault_name(Motor_Fault()),
+                   motor_health.fault_value);
+            pid_metrics_report();
 
             button_status = 0;   // 重置按钮状态
             READ_SPEED    = 0;   // 重置读取速度标志
@@ -961,19 +1098,43 @@ void pid_run(float kp, float ki, float kd, float ts, float T, float out_min, flo
             show_flag     = 1; // 设置显示标志
         }
 
-        // 打印目标速度和电机速度到串口
-        printf("%.2f,%.2f\r\n", target_speed, motor_speed);
+        // 打印目标值和实际值到串口
+        printf("%.2f,%.2f\r\n", target_value, actual_value);
 
-        // 计算目标速度和电机速度在OLED屏幕上的显示位置
-        if (target_speed >= 0)
+        // 左右按钮切换曲线页和性能指标页
+        if (button_status == BUTTON_LEFT || button_status == BUTTON_RIGHT)
         {
-            ts_y = (target_speed / out_max) * 50;
-            vs_y = (motor_speed / out_max) * 50;
+            button_status = 0;
+            metrics_page  = !metrics_page;
+            if (metrics_page)
+            {
+                pid_metrics_report();
+            }
+            else
+            {
+                // 回到曲线页时从头重绘
+                OLED_NewFrame();
+                OLED_DrawLine(0, 0, 0, 50, OLED_COLOR_NORMAL);    // 绘制左侧垂直线
+                OLED_DrawLine(0, 50, 120, 50, OLED_COLOR_NORMAL); // 绘制底部水平线
+                show_x = 0;
+            }
+        }
+        if (metrics_page)
+        {
+            pid_metrics_page();
+            continue;
+        }
+
+        // 计算目标值和实际值在OLED屏幕上的显示位置
+        if (target_value >= 0)
+        {
+            ts_y = (target_value / scale_max) * 50;
+            vs_y = (actual_value / scale_max) * 50;
         }
         else
         {
-            ts_y = (target_speed / out_min) * 50;
-            vs_y = (motor_speed / out_min) * 50;
+            ts_y = (target_value / scale_min) * 50;
+            vs_y = (actual_value / scale_min) * 50;
         }
 
         // 如果显示标志为0，则在OLED屏幕上绘制速度曲线
@@ -993,17 +1154,276 @@ void pid_run(float kp, float ki, float kd, float ts, float T, float out_min, flo
             }
         }
 
-        // 在OLED屏幕上显示目标速度和电机速度的标签和值
-        OLED_PrintASCIIString(0, 56, "TS:", &afont8x6, OLED_COLOR_NORMAL); // 显示目标速度标签
-        OLED_PrintASCIIString(64, 56, "VS:", &afont8x6, OLED_COLOR_NORMAL); // 显示电机速度标签
-        OLED_PrintASCIIString(20, 56, str_ts, &afont8x6, OLED_COLOR_NORMAL); // 显示目标速度值
-        OLED_PrintASCIIString(84, 56, str_vs, &afont8x6, OLED_COLOR_NORMAL); // 显示电机速度值
+        // 在OLED屏幕上显示目标速度和电机速度的标签和值，健康监测锁存故障后改为显示故障码
+        MotorFault fault = motor_fault_poll();
+        if (fault != MOTOR_FAULT_NONE)
+        {
+            OLED_PrintASCIIString(0, 56, "FAULT:", &afont8x6, OLED_COLOR_NORMAL);
+            OLED_PrintASCIIString(36, 56, motor_health_fault_name(fault), &afont8x6,
+                                  OLED_COLOR_NORMAL);
+            OLED_PrintASCIIString(84, 56, str_vs, &afont8x6, OLED_COLOR_NORMAL);
+        }
+        else
+        {
+            OLED_PrintASCIIString(0, 56, "TS:", &afont8x6, OLED_COLOR_NORMAL); // 显示目标速度标签
+            OLED_PrintASCIIString(64, 56, "VS:", &afont8x6, OLED_COLOR_NORMAL); // 显示电机速度标签
+            OLED_PrintASCIIString(20, 56, str_ts, &afont8x6, OLED_COLOR_NORMAL); // 目标速度值
+            OLED_PrintASCIIString(84, 56, str_vs, &afont8x6, OLED_COLOR_NORMAL); // 电机速度值
+        }
 
         // 刷新OLED屏幕以显示更新的界面
         OLED_ShowFrame();
     }
 }
 
+// 自整定规则在结果界面中的显示名称，顺序与PIDTuneRule一致
+static char* pid_tune_rule_names[PID_TUNE_RULE_COUNT] = {"Z-N", "T-L"};
+
+/**
+ * @brief 运行继电反馈自整定，完成后在OLED和串口上显示结果
+ *
+ * 自整定进行中显示当前速度和已运行时间；完成后显示Ku、Pu以及按所选规则换算的PID参数，
+ * 左右按钮切换Ziegler–Nichols / Tyreus–Luyben规则，重置按钮退出并把参数写入pid。
+ * @param kp 比例系数（自整定前的初值）
+ * @param ki 积分系数（自整定前的初值）
+ * @param kd 微分系数（自整定前的初值）
+ * @param ts 目标速度（继电振荡中心）
+ * @param T 采样时间
+ * @param out_min 输出最小值
+ * @param out_max 输出最大值
+ * @param tau 滤波时间常数
+ * @return 1 表示自整定成功且参数已写入pid，0 表示失败或被中断
+ */
+int pid_autotune_run(float kp, float ki, float kd, float ts, float T, float out_min, float out_max,
+                     float tau)
+{
+    extern float motor_speed;  // 声明外部电机速度变量
+    extern uint8_t READ_SPEED; // 声明外部读取速度标志变量
+    PIDTuneRule rule = PID_TUNE_TYREUS_LUYBEN; // 默认使用较保守的Tyreus–Luyben规则
+    uint8_t reported = 0;                      // 结果是否已通过串口输出
+    float tune_kp = 0.0f, tune_ki = 0.0f, tune_kd = 0.0f;
+    char str[24];
+
+    READ_SPEED = 0;
+    // 先初始化PID，保证写入自整定结果时采样周期和限幅有效
+    pid_init(&pid, kp, ki, kd, T, out_min, out_max, tau);
+    Encoder_Motor_Init();
+    Motor_Autotune_Start(ts, T);
+
+    while (1)
+    {
+        // 如果重置按钮被按下，停止电机并在成功时写入参数
+        if (button_status == BUTTON_RST)
+        {
+            HAL_TIM_Base_Stop_IT(&htim2);            // 停止TIM2的中断
+            HAL_TIM_PWM_Stop(&htim1, TIM_CHANNEL_1); // 停止TIM1的PWM模式通道1
+            Encoder_Motor_SetSpeed(3, 0);            // 桥臂滑行（PWM已停止，方向引脚立即切换）
+
+            button_status = 0;   // 重置按钮状态
+            motor_speed   = 0.0; // 重置电机速度
+            return Motor_Autotune_Apply(rule);
+        }
+
+        OLED_NewFrame();
+        OLED_PrintString(0, 0, "AUTOTUNE", &font16x16, OLED_COLOR_NORMAL);
+
+        if (motor_fault_poll() != MOTOR_FAULT_NONE)
+        {
+            // 健康监测切断了输出，自整定无法完成
+            OLED_PrintString(0, 24, motor_health_fault_name(Motor_Fault()), &font16x16,
+                             OLED_COLOR_NORMAL);
+        }
+        else if (pid_autotune.state == PID_AUTOTUNE_RUNNING)
+        {
+            sprintf(str, "VS:%.2f", motor_speed);
+            OLED_PrintASCIIString(0, 24, str, &afont8x6, OLED_COLOR_NORMAL);
+            sprintf(str, "T:%.1fs", pid_autotune.tick * pid_autotune.Ts);
+            OLED_PrintASCIIString(0, 40, str, &afont8x6, OLED_COLOR_NORMAL);
+            printf("%.2f,%.2f\r\n", ts, motor_speed);
+        }
+        else if (pid_autotune.state == PID_AUTOTUNE_DONE)
+        {
+            // 左右按钮切换整定规则
+            if (button_status == BUTTON_LEFT || button_status == BUTTON_RIGHT)
+            {
+                button_status = 0;
+                rule          = (rule + 1) % PID_TUNE_RULE_COUNT;
+                reported      = 0;
+            }
+            pid_autotune_gains(&pid_autotune, rule, &tune_kp, &tune_ki, &tune_kd);
+
+            OLED_PrintString(100, 0, pid_tune_rule_names[rule], &font16x16, OLED_COLOR_NORMAL);
+            sprintf(str, "Ku:%.3f Pu:%.2fs", pid_autotune.Ku, pid_autotune.Pu);
+            OLED_PrintASCIIString(0, 24, str, &afont8x6, OLED_COLOR_NORMAL);
+            sprintf(str, "KP:%.2f KI:%.2f", tune_kp, tune_ki);
+            OLED_PrintASCIIString(0, 40, str, &afont8x6, OLED_COLOR_NORMAL);
+            sprintf(str, "KD:%.2f", tune_kd);
+            OLED_PrintASCIIString(0, 56, str, &afont8x6, OLED_COLOR_NORMAL);
+
+            if (!reported)
+            {
+                printf("AUTOTUNE %s Ku=%.4f Pu=%.3f Kp=%.4f Ki=%.4f Kd=%.4f\r\n",
+                       pid_tune_rule_names[rule], pid_autotune.Ku, pid_autotune.Pu, tune_kp,
+                       tune_ki, tune_kd);
+                reported = 1;
+            }
+        }
+        else
+        {
+            OLED_PrintString(0, 24, "FAILED", &font16x16, OLED_COLOR_NORMAL);
+            if (!reported)
+            {
+                printf("AUTOTUNE FAILED\r\n");
+                reported = 1;
+            }
+        }
+
+        OLED_ShowFrame();
+    }
+}
+
+// 阶跃测试整定规则在结果界面中的显示名称，顺序与PIDFopdtRule一致
+static char* pid_fopdt_rule_names[PID_FOPDT_RULE_COUNT] = {"SIMC", "IMC"};
+
+/**
+ * @brief 运行开环阶跃测试，完成后拟合FOPDT模型并显示建议参数
+ *
+ * 记录中显示当前速度和已记录的时间；完成后显示K、τ、θ以及按所选规则换算的PID参数，
+ * 左右按钮切换SIMC / IMC规则，中间按钮接受参数并退出，重置按钮放弃参数并退出。
+ * @param kp 比例系数（测试前的初值）
+ * @param ki 积分系数（测试前的初值）
+ * @param kd 微分系数（测试前的初值）
+ * @param ts 阶跃后的控制量（为0时使用默认值）
+ * @param T 采样时间
+ * @param out_min 输出最小值
+ * @param out_max 输出最大值
+ * @param tau 滤波时间常数
+ * @return 1 表示参数已写入pid，0 表示失败或放弃
+ */
+int pid_step_test_run(float kp, float ki, float kd, float ts, float T, float out_min,
+                      float out_max, float tau)
+{
+    extern float motor_speed;  // 声明外部电机速度变量
+    extern uint8_t READ_SPEED; // 声明外部读取速度标志变量
+    PIDFopdtRule rule = PID_FOPDT_SIMC;
+    uint8_t reported  = 0; // 结果是否已通过串口输出
+    float fit_kp = 0.0f, fit_ki = 0.0f, fit_kd = 0.0f;
+    char str[24];
+
+    READ_SPEED = 0;
+    // 先初始化PID，保证写入拟合结果时采样周期和限幅有效
+    pid_init(&pid, kp, ki, kd, T, out_min, out_max, tau);
+    Encoder_Motor_Init();
+    Motor_Step_Test_Start(ts, T);
+
+    while (1)
+    {
+        // 重置按钮：放弃参数退出；中间按钮：拟合成功时接受参数退出
+        if (button_status == BUTTON_RST ||
+            (button_status == BUTTON_MID && motor_step_test.state == PID_STEP_TEST_FITTED &&
+             Motor_Fault() == MOTOR_FAULT_NONE))
+        {
+            uint8_t accept = button_status == BUTTON_MID;
+            HAL_TIM_Base_Stop_IT(&htim2);            // 停止TIM2的中断
+            HAL_TIM_PWM_Stop(&htim1, TIM_CHANNEL_1); // 停止TIM1的PWM模式通道1
+            Encoder_Motor_SetSpeed(3, 0);            // 桥臂滑行（PWM已停止，方向引脚立即切换）
+
+            button_status = 0;   // 重置按钮状态
+            motor_speed   = 0.0; // 重置电机速度
+            return accept ? Motor_Step_Test_Apply(rule) : 0;
+        }
+
+        // 记录完成后在主循环中拟合（O(N)，不放在中断里）
+        if (motor_step_test.state == PID_STEP_TEST_DONE)
+        {
+            pid_step_test_fit(&motor_step_test);
+        }
+
+        OLED_NewFrame();
+        OLED_PrintString(0, 0, "STEP", &font16x16, OLED_COLOR_NORMAL);
+
+        if (motor_fault_poll() != MOTOR_FAULT_NONE)
+        {
+            // 健康监测切断了输出，记录的数据不可用于拟合
+            OLED_PrintString(0, 24, motor_health_fault_name(Motor_Fault()), &font16x16,
+                             OLED_COLOR_NORMAL);
+        }
+        else if (motor_step_test.state == PID_STEP_TEST_BASELINE ||
+                 motor_step_test.state == PID_STEP_TEST_RECORDING)
+        {
+            sprintf(str, "VS:%.2f", motor_speed);
+            OLED_PrintASCIIString(0, 24, str, &afont8x6, OLED_COLOR_NORMAL);
+            sprintf(str, "%s T:%.1fs",
+                    motor_step_test.state == PID_STEP_TEST_BASELINE ? "BASE" : "STEP",
+                    motor_step_test.tick * motor_step_test.Ts);
+            OLED_PrintASCIIString(0, 40, str, &afont8x6, OLED_COLOR_NORMAL);
+            printf("%.2f,%.2f\r\n", motor_output, motor_speed);
+        }
+        else if (motor_step_test.state == PID_STEP_TEST_FITTED)
+        {
+            // 左右按钮切换整定规则
+            if (button_status == BUTTON_LEFT || button_status == BUTTON_RIGHT)
+            {
+                button_status = 0;
+                rule          = (rule + 1) % PID_FOPDT_RULE_COUNT;
+                reported      = 0;
+            }
+            pid_step_test_gains(&motor_step_test, rule, &fit_kp, &fit_ki, &fit_kd);
+
+            OLED_PrintString(88, 0, pid_fopdt_rule_names[rule], &font16x16, OLED_COLOR_NORMAL);
+            sprintf(str, "K:%.3f T:%.2f L:%.2f", motor_step_test.K, motor_step_test.tau,
+                    motor_step_test.theta);
+            OLED_PrintASCIIString(0, 24, str, &afont8x6, OLED_COLOR_NORMAL);
+            sprintf(str, "KP:%.2f KI:%.2f", fit_kp, fit_ki);
+            OLED_PrintASCIIString(0, 40, str, &afont8x6, OLED_COLOR_NORMAL);
+            sprintf(str, "KD:%.2f MID:OK", fit_kd);
+            OLED_PrintASCIIString(0, 56, str, &afont8x6, OLED_COLOR_NORMAL);
+
+            if (!reported)
+            {
+                printf("STEP %s K=%.4f tau=%.3f theta=%.3f Kp=%.4f Ki=%.4f Kd=%.4f\r\n",
+                       pid_fopdt_rule_names[rule], motor_step_test.K, motor_step_test.tau,
+                       motor_step_test.theta, fit_kp, fit_ki, fit_kd);
+                reported = 1;
+            }
+        }
+        else
+        {
+            OLED_PrintString(0, 24, "FAILED", &font16x16, OLED_COLOR_NORMAL);
+            if (!reported)
+            {
+                printf("STEP FAILED\r\n");
+                reported = 1;
+            }
+        }
+
+        OLED_ShowFrame();
+    }
+}
+
+/**
+ * @brief 把PID参数限制在参数调整界面可编辑的范围内[0, 99.99]
+ * @param v 参数值
+ * @return 限幅后的参数值
+ */
+static float pid_gain_limit(float v)
+{
+    if (v > 99.99f)
+    {
+        return 99.99f;
+    }
+    if (v < 0.0f)
+    {
+        return 0.0f;
+    }
+    return v;
+}
+
+// 控制模式在菜单中的显示名称，顺序与MotorControlMode一致
+static char* pid_mode_names[MOTOR_MODE_COUNT] = {"SPD", "POS", "ATN", "GSC", "INC", "FIT"};
+// 测速估计器在菜单中的显示名称，顺序与MotorSpeedEstimator一致
+static char* pid_estimator_names[MOTOR_ESTIMATOR_COUNT] = {"EMA", "A-B", "KF", "M/T"};
+
 /**
  * @brief 显示PID参数调整界面并处理按钮输入以选择和调整PID参数及运行PID控制器
  * @param 无参数
@@ -1038,6 +1458,14 @@ int pid_function()
         OLED_PrintString(16, 0, "KP", &font16x16, OLED_COLOR_NORMAL);
         OLED_PrintString(40, 0, str_kp, &font16x16, OLED_COLOR_NORMAL);
         OLED_PrintString(100, 0, "RUN", &font16x16, OLED_COLOR_NORMAL);
+        OLED_PrintString(100, 16, pid_mode_names[motor_control_mode], &font16x16,
+                         OLED_COLOR_NORMAL);
+        // 目标值整形方式：SCV为S曲线轨迹，STP为直接阶跃
+        OLED_PrintString(100, 32, motor_trajectory_enabled ? "SCV" : "STP", &font16x16,
+                         OLED_COLOR_NORMAL);
+        // 测速估计器
+        OLED_PrintString(100, 48, pid_estimator_names[motor_speed_estimator], &font16x16,
+                         OLED_COLOR_NORMAL);
 
         OLED_PrintString(16, 16, "KI", &font16x16, OLED_COLOR_NORMAL);
         OLED_PrintString(40, 16, str_ki, &font16x16, OLED_COLOR_NORMAL);
@@ -1054,7 +1482,7 @@ int pid_function()
         {
             button_status = 0; // 重置按钮状态
             flag++;            // 选择下一个菜单项
-            if (flag > 4)
+            if (flag > 7)
             {
                 flag = 0; // 循环选择
             }
@@ -1065,7 +1493,7 @@ int pid_function()
             flag--;            // 选择上一个菜单项
             if (flag < 0)
             {
-                flag = 4; // 循环选择
+                flag = 7; // 循环选择
             }
         }
 
@@ -1106,12 +1534,51 @@ int pid_function()
         {
             ts = pid_ts(ts); // 调整ts值
         }
+        else if (menu3_flag == 5 && motor_control_mode == MOTOR_MODE_AUTOTUNE)
+        {
+            // 运行自整定，成功时把结果带回参数界面
+            if (pid_autotune_run(kp, ki, kd, ts, motor_control_period, -FULL_SPEED_RPM,
+                                 FULL_SPEED_RPM, 0.3))
+            {
+                kp = pid_gain_limit(pid.Kp);
+                ki = pid_gain_limit(pid.Ki);
+                kd = pid_gain_limit(pid.Kd);
+            }
+            Encoder_Motor_SetSpeed(3, 0);
+        }
+        else if (menu3_flag == 5 && motor_control_mode == MOTOR_MODE_STEP_TEST)
+        {
+            // 运行阶跃测试，接受建议参数时把结果带回参数界面
+            if (pid_step_test_run(kp, ki, kd, ts, motor_control_period, -FULL_SPEED_RPM,
+                                  FULL_SPEED_RPM, 0.3))
+            {
+                kp = pid_gain_limit(pid.Kp);
+                ki = pid_gain_limit(pid.Ki);
+                kd = pid_gain_limit(pid.Kd);
+            }
+            Encoder_Motor_SetSpeed(3, 0);
+        }
         else if (menu3_flag == 5)
         {
             // 运行PID控制器
-            pid_run(kp, ki, kd, ts, 0.1, -FULL_SPEED_RPM, FULL_SPEED_RPM, 0.3);
+            pid_run(kp, ki, kd, ts, motor_control_period, -FULL_SPEED_RPM, FULL_SPEED_RPM, 0.3);
             Encoder_Motor_SetSpeed(3, 0);
         }
+        else if (menu3_flag == 6)
+        {
+            // 切换控制模式
+            motor_control_mode = (motor_control_mode + 1) % MOTOR_MODE_COUNT;
+        }
+        else if (menu3_flag == 7)
+        {
+            // 切换目标值是否经过S曲线轨迹
+            motor_trajectory_enabled = !motor_trajectory_enabled;
+        }
+        else if (menu3_flag == 8)
+        {
+            // 切换测速估计器
+            Motor_Set_Speed_Estimator((motor_speed_estimator + 1) % MOTOR_ESTIMATOR_COUNT);
+        }
 
         // 重置menu3_flag
         menu3_flag = 0;
@@ -1150,6 +1617,27 @@ int pid_function()
             OLED_PrintString(0, 32, " ", &font16x16, OLED_COLOR_NORMAL); // 取消高亮KD
             OLED_PrintString(0, 48, " ", &font16x16, OLED_COLOR_NORMAL); // 取消高亮TS
             break;
+        case 5:
+            OLED_PrintString(90, 16, ">", &font16x16, OLED_COLOR_NORMAL); // 高亮MODE
+            OLED_PrintString(0, 0, " ", &font16x16, OLED_COLOR_NORMAL);   // 取消高亮KP
+            OLED_PrintString(0, 16, " ", &font16x16, OLED_COLOR_NORMAL);  // 取消高亮KI
+            OLED_PrintString(0, 32, " ", &font16x16, OLED_COLOR_NORMAL);  // 取消高亮KD
+            OLED_PrintString(0, 48, " ", &font16x16, OLED_COLOR_NORMAL);  // 取消高亮TS
+            break;
+        case 6:
+            OLED_PrintString(90, 32, ">", &font16x16, OLED_COLOR_NORMAL); // 高亮轨迹开关
+            OLED_PrintString(0, 0, " ", &font16x16, OLED_COLOR_NORMAL);   // 取消高亮KP
+            OLED_PrintString(0, 16, " ", &font16x16, OLED_COLOR_NORMAL);  // 取消高亮KI
+            OLED_PrintString(0, 32, " ", &font16x16, OLED_COLOR_NORMAL);  // 取消高亮KD
+            OLED_PrintString(0, 48, " ", &font16x16, OLED_COLOR_NORMAL);  // 取消高亮TS
+            break;
+        case 7:
+            OLED_PrintString(90, 48, ">", &font16x16, OLED_COLOR_NORMAL); // 高亮测速估计器
+            OLED_PrintString(0, 0, " ", &font16x16, OLED_COLOR_NORMAL);   // 取消高亮KP
+            OLED_PrintString(0, 16, " ", &font16x16, OLED_COLOR_NORMAL);  // 取消高亮KI
+            OLED_PrintString(0, 32, " ", &font16x16, OLED_COLOR_NORMAL);  // 取消高亮KD
+            OLED_PrintString(0, 48, " ", &font16x16, OLED_COLOR_NORMAL);  // 取消高亮TS
+            break;
         default:
             break;
         }
@@ -3,6 +3,18 @@
 
 #include "stdint.h"
 
+// pid_update_dt：实测周期与标称 Ts 的相对偏差超过该值时才按 dt / Ts 缩放积分和微分项
+#define PID_DT_TOLERANCE 0.001f
+
+// 积分抗饱和（anti-windup）策略
+typedef enum
+{
+    PID_AW_UNDO = 0,         // 输出饱和时撤销本拍积分累加量（默认）
+    PID_AW_BACK_CALCULATION, // 反算法：integrator += Kaw * Ts * (限幅后输出 - 限幅前输出)
+    PID_AW_CONDITIONAL,      // 条件积分：输出饱和且误差继续推向饱和方向时停止积分
+    PID_AW_CLAMP             // 仅把积分器限制在 [integ_min, integ_max]
+} PIDAntiWindup;
+
 // PID控制器结构体定义
 typedef struct
 {
@@ -18,6 +30,24 @@ typedef struct
     float prev_measurement;
     float differentiator; // 用于滤波的微分项状态
     float tau;            // 微分滤波时间常数（tau >= 0）
+    // 二自由度：设定值加权（P 项输入为 b*r - y，D 项输入为 c*r - y）
+    float b; // 比例项设定值权重（pid_init 默认 1）
+    float c; // 微分项设定值权重（pid_init 默认：tau > 0 时为 0，即测量值微分；否则为 1）
+    // 积分抗饱和
+    PIDAntiWindup anti_windup; // 抗饱和策略
+    float Kaw;                 // 反算法增益（1/秒），仅 PID_AW_BACK_CALCULATION 使用
+    float integ_min;           // 积分器下界（pid_init 默认取 out_min）
+    float integ_max;           // 积分器上界（pid_init 默认取 out_max）
+    // 与增益无关的时间系数（仅在 pid_init / pid_set_sample_time 中刷新，含除法）
+    float half_ts;        // 0.5 * Ts
+    float inv_ts;         // 1 / Ts
+    float d_filter_scale; // 2 / ((2*tau + Ts) * Ts)
+    // 预计算系数缓存（在 pid_init / pid_set_gains / pid_set_sample_time 中刷新，只用乘法）
+    float ki_half_ts; // 0.5 * Ki * Ts，梯形积分系数
+    float kd_diff;    // Kd / Ts，tau <= 0 时的误差差分系数
+    float alpha;      // (2*tau - Ts) / (2*tau + Ts)，微分低通滤波系数
+    float kd_filter;  // 2*Kd / ((2*tau + Ts) * Ts)，测量值微分系数
+    float kaw_ts;     // Kaw * Ts，反算法系数
 }PIDController;
 
 extern PIDController pid;
@@ -25,8 +55,24 @@ extern PIDController pid;
 void pid_init(PIDController* pid, float Kp, float Ki, float Kd, float Ts, float out_min, float out_max,
               float tau);
 void pid_reset(PIDController* pid);
+// 运行中修改增益（无扰切换，不会引起输出跳变）
+void pid_set_gains(PIDController* pid, float Kp, float Ki, float Kd);
+// 运行中修改采样周期和微分滤波时间常数
+void pid_set_sample_time(PIDController* pid, float Ts, float tau);
+// 选择积分抗饱和策略，并设置反算法增益和积分器范围
+void pid_set_anti_windup(PIDController* pid, PIDAntiWindup mode, float Kaw, float integ_min,
+                         float integ_max);
+// 设置二自由度设定值权重
+void pid_set_setpoint_weights(PIDController* pid, float b, float c);
 // 计算PID控制器输出
 float pid_update(PIDController* pid, float setpoint, float measurement);
+// 计算PID控制器输出，并叠加前馈量（前馈参与限幅和抗积分饱和）
+float pid_update_ff(PIDController* pid, float setpoint, float measurement, float feedforward);
+// 按实测采样间隔 dt（秒）计算PID控制器输出，不修改标称 Ts，dt <= 0 时按标称 Ts 计算
+float pid_update_dt(PIDController* pid, float setpoint, float measurement, float dt);
+// 按实测采样间隔 dt（秒）计算PID控制器输出，并叠加前馈量
+float pid_update_ff_dt(PIDController* pid, float setpoint, float measurement, float feedforward,
+                       float dt);
 
 
 
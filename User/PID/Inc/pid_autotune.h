@@ -0,0 +1,58 @@
+#ifndef PID_AUTOTUNE_H
+#define PID_AUTOTUNE_H
+
+#include "stdint.h"
+
+// 继电反馈自整定状态
+typedef enum
+{
+    PID_AUTOTUNE_IDLE = 0, // 未启动
+    PID_AUTOTUNE_RUNNING,  // 继电振荡中
+    PID_AUTOTUNE_DONE,     // 已测得临界增益和临界周期
+    PID_AUTOTUNE_FAILED    // 超时未形成稳定振荡
+} PIDAutotuneState;
+
+// 由临界增益/临界周期换算PID参数的整定规则
+typedef enum
+{
+    PID_TUNE_ZIEGLER_NICHOLS = 0, // 响应快，超调较大
+    PID_TUNE_TYREUS_LUYBEN,       // 更保守，鲁棒性好
+    PID_TUNE_RULE_COUNT
+} PIDTuneRule;
+
+// Åström–Hägglund 继电反馈自整定器
+typedef struct
+{
+    // 配置
+    float setpoint;     // 振荡中心（设定值）
+    float bias;         // 继电输出的中心值
+    float amplitude;    // 继电输出幅值 d
+    float hysteresis;   // 继电切换滞环宽度 ε
+    float Ts;           // 采样周期（秒）
+    uint32_t max_ticks; // 超时节拍数
+    uint8_t cycles;     // 参与平均的振荡周期数
+    // 内部状态
+    PIDAutotuneState state;
+    int8_t relay;        // 当前继电方向 +1 / -1
+    uint32_t tick;       // 已运行节拍数
+    uint32_t last_rise;  // 上一次继电由 -1 切换到 +1 的节拍
+    uint8_t rises;       // 已检测到的 -1 -> +1 切换次数
+    float peak_max;      // 当前周期测量最大值
+    float peak_min;      // 当前周期测量最小值
+    float amplitude_sum; // 各周期振荡幅值之和
+    float period_sum;    // 各周期振荡周期之和（秒）
+    // 结果
+    float Ku; // 临界增益
+    float Pu; // 临界周期（秒）
+} PIDAutotune;
+
+// 初始化自整定器：围绕setpoint以bias±amplitude的继电输出激励对象
+void pid_autotune_init(PIDAutotune* tune, float setpoint, float bias, float amplitude,
+                       float hysteresis, float Ts, uint32_t max_ticks, uint8_t cycles);
+// 每个采样节拍调用一次，返回本节拍的执行器控制量
+float pid_autotune_update(PIDAutotune* tune, float measurement);
+// 按规则由Ku、Pu计算PID参数，自整定未完成时返回0
+uint8_t pid_autotune_gains(const PIDAutotune* tune, PIDTuneRule rule, float* Kp, float* Ki,
+                           float* Kd);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef PID_BANK_H
+#define PID_BANK_H
+
+#include "stdint.h"
+
+// 控制器组最多容纳的回路数
+#define PID_BANK_MAX_LOOPS 16
+
+// 多回路PID控制器组（结构体数组 -> 数组结构体布局，同一字段在内存中连续）
+typedef struct
+{
+    uint8_t count; // 已注册的回路数
+    // 热路径系数（由 pid_bank_add / pid_bank_set_gains 预先计算）
+    float Kp[PID_BANK_MAX_LOOPS];
+    float ki_half_ts[PID_BANK_MAX_LOOPS]; // 0.5 * Ki * Ts
+    float kd_diff[PID_BANK_MAX_LOOPS];    // tau <= 0 时为 Kd / Ts，否则为 0
+    float alpha[PID_BANK_MAX_LOOPS];      // tau > 0 时为 (2*tau - Ts) / (2*tau + Ts)，否则为 0
+    float kd_filter[PID_BANK_MAX_LOOPS];  // tau > 0 时为 2*Kd / ((2*tau + Ts) * Ts)，否则为 0
+    float out_min[PID_BANK_MAX_LOOPS];
+    float out_max[PID_BANK_MAX_LOOPS];
+    // 热路径状态
+    float integrator[PID_BANK_MAX_LOOPS];
+    float prev_error[PID_BANK_MAX_LOOPS];
+    float prev_measurement[PID_BANK_MAX_LOOPS];
+    float differentiator[PID_BANK_MAX_LOOPS];
+    // 冷数据：原始参数，仅在修改增益时使用
+    float Ki[PID_BANK_MAX_LOOPS];
+    float Kd[PID_BANK_MAX_LOOPS];
+    float Ts[PID_BANK_MAX_LOOPS];
+    float tau[PID_BANK_MAX_LOOPS];
+} PIDBank;
+
+// 清空控制器组
+void pid_bank_init(PIDBank* bank);
+// 添加一个回路，返回回路编号，组已满时返回 -1
+int pid_bank_add(PIDBank* bank, float Kp, float Ki, float Kd, float Ts, float out_min,
+                 float out_max, float tau);
+// 运行中修改某个回路的增益（无扰切换）
+void pid_bank_set_gains(PIDBank* bank, uint8_t index, float Kp, float Ki, float Kd);
+// 清零所有回路的内部状态
+void pid_bank_reset(PIDBank* bank);
+// 一次更新所有回路，数组长度均为 bank->count
+void pid_bank_update(PIDBank* bank, const float* setpoints, const float* measurements,
+                     float* outputs);
+
+#endif
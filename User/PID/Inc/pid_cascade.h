@@ -0,0 +1,27 @@
+#ifndef PID_CASCADE_H
+#define PID_CASCADE_H
+
+#include "pid.h"
+#include "stdint.h"
+
+// 串级PID控制器：外环（位置）输出作为内环（速度）的设定值
+typedef struct
+{
+    PIDController* outer; // 外环（位置环），输出为速度设定值
+    PIDController* inner; // 内环（速度环），输出为执行器控制量
+    uint8_t outer_divider; // 外环分频：每 outer_divider 个基础节拍运行一次
+    uint8_t inner_divider; // 内环分频：每 inner_divider 个基础节拍运行一次
+    uint8_t tick;          // 基础节拍计数
+    float speed_setpoint;  // 外环最近一次输出的速度设定值
+    float output;          // 内环最近一次输出的控制量
+} PIDCascade;
+
+// 初始化串级控制器（outer / inner 需事先用 pid_init 初始化，Ts 取基础节拍乘以各自分频）
+void pid_cascade_init(PIDCascade* cascade, PIDController* outer, PIDController* inner,
+                      uint8_t outer_divider, uint8_t inner_divider);
+void pid_cascade_reset(PIDCascade* cascade);
+// 每个基础节拍调用一次，返回执行器控制量
+float pid_cascade_update(PIDCascade* cascade, float position_setpoint, float position,
+                         float speed);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef PID_METRICS_H
+#define PID_METRICS_H
+
+#include "stdint.h"
+
+// 阶跃响应和控制性能指标（每个采样节拍 O(1) 更新，不保存历史数据）
+typedef struct
+{
+    // 配置
+    float initial;  // 阶跃前的测量值
+    float setpoint; // 阶跃后的设定值
+    float band;     // 调节时间判据：误差进入 ±band·|阶跃幅值| 并不再离开
+    float Ts;       // 采样周期（秒）
+    float inv_step; // 1 / (setpoint - initial)，阶跃幅值为 0 时为 0
+    // 统计
+    uint32_t tick;        // 已统计的节拍数
+    uint32_t rise_start;  // 首次到达 10% 的节拍，未到达时为 0
+    uint32_t rise_end;    // 首次到达 90% 的节拍，未到达时为 0
+    uint32_t settle_tick;     // 最后一次处于误差带之外的节拍
+    uint32_t saturated_ticks; // 执行器饱和的节拍数
+    float peak;               // 归一化响应 (y - initial) / 阶跃幅值 的最大值
+    float iae;                // 误差绝对值积分 ∫|e|dt
+    float ise;                // 误差平方积分 ∫e²dt
+    float itae;               // 时间加权误差绝对值积分 ∫t·|e|dt
+} PIDMetrics;
+
+// 开始统计一次阶跃响应，band 常取 0.02 或 0.05
+void pid_metrics_init(PIDMetrics* metrics, float initial, float setpoint, float band, float Ts);
+// 每个采样节拍调用一次，saturated 为本拍执行器是否处于饱和
+void pid_metrics_update(PIDMetrics* metrics, float measurement, uint8_t saturated);
+// 10% -> 90% 上升时间（秒），尚未到达 90% 时返回 -1
+float pid_metrics_rise_time(const PIDMetrics* metrics);
+// 超调量（百分比），没有超调时返回 0
+float pid_metrics_overshoot(const PIDMetrics* metrics);
+// 调节时间（秒）：最后一次离开误差带的时刻
+float pid_metrics_settling_time(const PIDMetrics* metrics);
+// 饱和占空比（百分比）：饱和节拍数 / 总节拍数
+float pid_metrics_saturation_duty(const PIDMetrics* metrics);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef PID_PLANT_H
+#define PID_PLANT_H
+
+#include "stdint.h"
+
+// 一阶惯性加纯滞后对象的最大滞后节拍数
+#define PID_PLANT_MAX_DELAY 64
+
+// 一阶惯性加纯滞后（FOPDT）对象：G(s) = K·e^(-Ls) / (τs + 1)
+typedef struct
+{
+    float gain;                        // 稳态增益 K
+    float alpha;                       // exp(-Ts/τ)，零阶保持精确离散化系数
+    uint8_t delay;                     // 纯滞后节拍数 round(L / Ts)
+    uint8_t head;                      // 滞后缓冲区写指针
+    float output;                      // 对象输出
+    float buffer[PID_PLANT_MAX_DELAY]; // 滞后缓冲区（环形）
+} PIDPlantFOPDT;
+
+// 带减速器的直流电机对象
+// 电枢回路 L·di/dt = V - R·i - Ke·ω，机械回路 J·dω/dt = Kt·i - b·ω - T_load
+typedef struct
+{
+    float R;          // 电枢电阻（Ω）
+    float L;          // 电枢电感（H）
+    float Ke;         // 反电动势常数（V·s/rad）
+    float Kt;         // 转矩常数（N·m/A）
+    float J;          // 折算到电机轴的转动惯量（kg·m²）
+    float b;          // 粘滞摩擦系数（N·m·s/rad）
+    float gear_ratio; // 减速比（电机轴转速 / 输出轴转速）
+    float h;          // 积分步长（秒）= Ts / substeps
+    uint8_t substeps; // 每个采样周期的积分子步数（电气时间常数远小于 Ts 时需要加大）
+    // 状态
+    float current; // 电枢电流（A）
+    float omega;   // 电机轴角速度（rad/s）
+    float angle;   // 电机轴累计转角（转）
+} PIDPlantDCMotor;
+
+// 增量式编码器量化模型：把连续转角变成整数计数，与 TIM3 编码器模式读数一致
+typedef struct
+{
+    float counts_per_rev; // 电机轴每转计数（线数 × 倍频）
+    int32_t last_count;   // 上一次读数时的累计计数
+} PIDPlantEncoder;
+
+// 初始化 FOPDT 对象，dead_time 超出 PID_PLANT_MAX_DELAY 个节拍时截断
+void pid_plant_fopdt_init(PIDPlantFOPDT* plant, float gain, float tau, float dead_time, float Ts);
+// 输入本拍控制量，返回对象输出
+float pid_plant_fopdt_step(PIDPlantFOPDT* plant, float input);
+
+void pid_plant_dc_motor_init(PIDPlantDCMotor* motor, float R, float L, float Ke, float Kt, float J,
+                             float b, float gear_ratio, float Ts, uint8_t substeps);
+// 输入本拍电枢电压和负载转矩（折算到电机轴），返回输出轴转速（转/分）
+float pid_plant_dc_motor_step(PIDPlantDCMotor* motor, float voltage, float load_torque);
+
+void pid_plant_encoder_init(PIDPlantEncoder* encoder, float counts_per_rev, float angle);
+// 读取自上次读取以来的计数差（angle 为电机轴累计转角，单位转）
+int32_t pid_plant_encoder_read(PIDPlantEncoder* encoder, float angle);
+
+#endif
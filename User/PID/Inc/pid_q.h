@@ -0,0 +1,59 @@
+#ifndef PID_Q_H
+#define PID_Q_H
+
+#include "stdint.h"
+
+// Q16.16 定点数：高 16 位为有符号整数部分，低 16 位为小数部分
+typedef int32_t q16_t;
+
+#define Q16_FRAC_BITS 16
+#define Q16_ONE ((q16_t)1 << Q16_FRAC_BITS)
+#define Q16_MAX ((q16_t)0x7FFFFFFF)
+#define Q16_MIN ((q16_t)0x80000000)
+
+// 浮点 <-> Q16.16 转换（仅在初始化或显示时使用，不要放进中断热路径）
+#define Q16_FROM_FLOAT(x) ((q16_t)((x) * 65536.0f + (((x) >= 0) ? 0.5f : -0.5f)))
+#define Q16_TO_FLOAT(x) ((float)(x) * (1.0f / 65536.0f))
+#define Q16_FROM_INT(x) ((q16_t)(x) << Q16_FRAC_BITS)
+#define Q16_TO_INT(x) ((int32_t)((x) >> Q16_FRAC_BITS))
+
+// 系数尾数的有效位数：|mant| < 2^30，与 33 位的输入差值相乘不会溢出 64 位
+#define PID_Q_COEF_BITS 30
+// 积分器在 Q16.16 之外多保留的小数位数，高采样率下每拍的积分增量只有几个 LSB
+#define PID_Q_INTEG_EXTRA_BITS 16
+
+// 定点系数：值 = mant / 2^shift，每个系数按自身大小选择 shift，
+// 0.5*Ki*Ts 这样很小的值和 Kd/Ts 这样很大的值都保留 PID_Q_COEF_BITS 位有效数字
+typedef struct
+{
+    int32_t mant;  // 尾数，|mant| < 2^PID_Q_COEF_BITS
+    uint8_t shift; // 右移位数（0 ~ 62），系数过大时为 0 且尾数饱和
+} PIDQCoef;
+
+// 定点PID控制器结构体定义（行为与 PIDController 一致）
+typedef struct
+{
+    // 预先计算好的系数（由 pid_q_init 根据浮点参数换算）
+    PIDQCoef Kp;
+    PIDQCoef ki_half_ts; // 0.5 * Ki * Ts * 2^PID_Q_INTEG_EXTRA_BITS，梯形积分系数
+    PIDQCoef kd_diff;    // tau <= 0 时：Kd / Ts，误差差分系数
+    PIDQCoef alpha;      // (2*tau - Ts) / (2*tau + Ts)，微分低通滤波系数
+    PIDQCoef kd_filter;  // 2*Kd / ((2*tau + Ts) * Ts)，测量值微分系数
+    uint8_t use_filter;
+    q16_t out_min; // 输出限幅下界
+    q16_t out_max; // 输出限幅上界
+    // 内部状态
+    int64_t integrator; // Q16.16 再扩展 PID_Q_INTEG_EXTRA_BITS 位小数
+    q16_t prev_error;
+    q16_t prev_measurement;
+    q16_t differentiator;
+} PIDControllerQ;
+
+// 初始化定点PID控制器（参数与 pid_init 相同，均为浮点）
+void pid_q_init(PIDControllerQ* pid, float Kp, float Ki, float Kd, float Ts, float out_min,
+                float out_max, float tau);
+void pid_q_reset(PIDControllerQ* pid);
+// 计算定点PID控制器输出（设定值、测量值与返回值均为 Q16.16）
+q16_t pid_q_update(PIDControllerQ* pid, q16_t setpoint, q16_t measurement);
+
+#endif
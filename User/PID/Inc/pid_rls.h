@@ -0,0 +1,35 @@
+#ifndef PID_RLS_H
+#define PID_RLS_H
+
+#include "stdint.h"
+
+// 一阶离散模型 y[k] = a·y[k-1] + b·u[k-1] 的递推最小二乘（RLS）在线辨识器
+typedef struct
+{
+    // 配置
+    float lambda; // 遗忘因子（0.95 ~ 1），越小跟踪参数变化越快、噪声越大
+    float p0;     // 协方差初值，也是协方差对角元的上限
+    float Ts;     // 采样周期（秒）
+    // 估计值
+    float a; // 极点
+    float b; // 输入增益
+    // 内部状态（固定大小，不使用堆）
+    float P[2][2];    // 参数协方差矩阵
+    float prev_y;     // 上一拍输出
+    float prev_u;     // 上一拍输入
+    uint8_t primed;   // 是否已有上一拍数据
+    float error_var;  // 一步预测误差平方的指数平均
+    uint32_t updates; // 已完成的递推次数
+} PIDRls;
+
+void pid_rls_init(PIDRls* rls, float lambda, float p0, float Ts);
+// 每个采样节拍调用一次：input 为本拍施加的控制量，output 为本拍测得的输出
+void pid_rls_update(PIDRls* rls, float input, float output);
+// 置信度 [0, 1]：由协方差迹相对初值的收缩程度给出，激励不足时随遗忘逐渐下降
+float pid_rls_confidence(const PIDRls* rls);
+// 换算连续时间一阶模型 K / (τs + 1)，模型不稳定或无效时返回 0
+uint8_t pid_rls_model(const PIDRls* rls, float* K, float* tau);
+// 按极点配置为 PI 控制器整定：闭环特征方程 s² + 2ζω·s + ω²，模型无效时返回 0
+uint8_t pid_rls_pole_placement(const PIDRls* rls, float zeta, float omega, float* Kp, float* Ki);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef PID_SCHEDULE_H
+#define PID_SCHEDULE_H
+
+#include "pid.h"
+#include "stdint.h"
+
+// 增益调度表断点：调度变量为 x 时使用的一组增益（表按 x 升序排列，声明为 const 放在 Flash 中）
+typedef struct
+{
+    float x;
+    float Kp;
+    float Ki;
+    float Kd;
+} PIDGainPoint;
+
+// 增益调度器
+typedef struct
+{
+    const PIDGainPoint* table; // 断点表
+    uint8_t count;             // 断点数（>= 1）
+    uint8_t segment;           // 上次命中的区间 [segment, segment + 1]
+    float inv_span;            // 当前区间宽度的倒数，区间变化时才重新计算
+} PIDGainSchedule;
+
+// 初始化增益调度器
+void pid_schedule_init(PIDGainSchedule* schedule, const PIDGainPoint* table, uint8_t count);
+// 按调度变量 x 线性插值得到增益（x 超出表范围时取端点增益）
+void pid_schedule_lookup(PIDGainSchedule* schedule, float x, float* Kp, float* Ki, float* Kd);
+// 查表并以无扰方式写入PID控制器
+void pid_schedule_apply(PIDGainSchedule* schedule, PIDController* pid, float x);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef PID_STEP_TEST_H
+#define PID_STEP_TEST_H
+
+#include "stdint.h"
+
+// 环形缓冲区长度（采样点数），记录时长为 PID_STEP_TEST_SAMPLES * Ts * decimation
+#define PID_STEP_TEST_SAMPLES 256
+// 阶跃前保留在缓冲区中的基线采样点数
+#define PID_STEP_TEST_PRE_SAMPLES 16
+// 稳态判据：最后 1/8 采样的前后两半平均值之差不超过阶跃响应幅值的这一比例
+#define PID_STEP_TEST_SETTLE_TOLERANCE 0.02f
+
+// 阶跃测试状态
+typedef enum
+{
+    PID_STEP_TEST_IDLE = 0,  // 未启动
+    PID_STEP_TEST_BASELINE,  // 施加初始控制量，记录基线
+    PID_STEP_TEST_RECORDING, // 已施加阶跃，记录响应
+    PID_STEP_TEST_DONE,      // 记录完成，可调用 pid_step_test_fit
+    PID_STEP_TEST_FITTED,    // 已拟合出 FOPDT 模型
+    PID_STEP_TEST_FAILED     // 响应太小或未达到稳态，拟合失败
+} PIDStepTestState;
+
+// 由 FOPDT 模型换算PID参数的整定规则
+typedef enum
+{
+    PID_FOPDT_SIMC = 0, // Skogestad SIMC PI，τc = θ
+    PID_FOPDT_IMC,      // IMC PID，λ = max(θ, 0.2τ)
+    PID_FOPDT_RULE_COUNT
+} PIDFopdtRule;
+
+// 开环阶跃测试与一阶惯性加纯滞后（FOPDT）模型拟合
+typedef struct
+{
+    // 配置
+    float u0;                  // 阶跃前的控制量
+    float u1;                  // 阶跃后的控制量
+    float Ts;                  // 记录的采样间隔（秒）：控制周期 * decimation
+    uint16_t decimation;       // 每隔多少个控制节拍记录一个采样点
+    uint16_t baseline_samples; // 阶跃前记录的采样点数（不少于 PID_STEP_TEST_PRE_SAMPLES）
+    // 记录
+    PIDStepTestState state;
+    uint16_t phase;                       // 距上一次记录已经过的控制节拍数
+    uint16_t tick;                        // 当前阶段已记录的采样点数
+    uint16_t head;                        // 环形缓冲区写指针（指向最旧的数据）
+    float samples[PID_STEP_TEST_SAMPLES]; // 环形缓冲区
+    // 拟合结果
+    float K;     // 稳态增益 Δy / Δu
+    float tau;   // 时间常数（秒）
+    float theta; // 纯滞后（秒）
+} PIDStepTest;
+
+// 初始化阶跃测试：先以 u0 运行至少 baseline_ticks 拍，再阶跃到 u1 记录响应；
+// Ts 为控制周期，每 decimation 拍记录一个采样点，控制频率较高时用它让缓冲区覆盖足够长的响应
+void pid_step_test_init(PIDStepTest* test, float u0, float u1, float Ts, uint32_t baseline_ticks,
+                        uint16_t decimation);
+// 每个控制节拍调用一次，返回本拍应施加的控制量
+float pid_step_test_update(PIDStepTest* test, float measurement);
+// 记录完成后拟合 FOPDT 模型（两点法），成功返回 1；计算量为 O(N)，不要在中断中调用
+uint8_t pid_step_test_fit(PIDStepTest* test);
+// 按规则由拟合结果计算PID参数，未拟合成功时返回 0
+uint8_t pid_step_test_gains(const PIDStepTest* test, PIDFopdtRule rule, float* Kp, float* Ki,
+                            float* Kd);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef PID_VELOCITY_H
+#define PID_VELOCITY_H
+
+#include "stdint.h"
+
+// 增量式（速度型）PID控制器结构体定义
+typedef struct
+{
+    float Kp;
+    float Ki;
+    float Kd;
+    float Ts;      // 采样周期（秒）
+    float tau;     // 微分滤波时间常数（tau >= 0）
+    float out_min; // 输出限幅下界
+    float out_max; // 输出限幅上界
+    // 预计算系数（在 pid_velocity_init 和 pid_velocity_set_sample_time 中刷新）
+    float ki_ts;     // Ki * Ts
+    float kd_diff;   // Kd / Ts，tau <= 0 时的误差差分系数
+    float alpha;     // (2*tau - Ts) / (2*tau + Ts)
+    float kd_filter; // 2*Kd / ((2*tau + Ts) * Ts)
+    // 内部状态
+    float prev_error;
+    float prev_measurement;
+    float differentiator; // 上一拍的微分项
+    float output;         // 上一拍实际输出到执行器的控制量
+} PIDVelocity;
+
+void pid_velocity_init(PIDVelocity* pid, float Kp, float Ki, float Kd, float Ts, float out_min,
+                       float out_max, float tau);
+// 运行中修改采样周期和微分滤波时间常数，保留上一拍的控制量
+void pid_velocity_set_sample_time(PIDVelocity* pid, float Ts, float tau);
+// 手动控制期间调用：让控制器跟踪执行器的实际控制量和当前测量值，切回闭环时无扰
+void pid_velocity_track(PIDVelocity* pid, float output, float setpoint, float measurement);
+// 计算增量并累加到上一拍控制量上，返回限幅后的控制量
+float pid_velocity_update(PIDVelocity* pid, float setpoint, float measurement);
+
+#endif
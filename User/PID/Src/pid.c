@@ -20,6 +20,33 @@
 #include "pid.h"
 #include <stdint.h>
 
+/* 刷新与增益相关的系数：只用乘法，增益调度每拍调用也不会引入除法 */
+static void pid_update_gain_coefficients(PIDController* pid)
+{
+    pid->ki_half_ts = pid->Ki * pid->half_ts;
+    pid->kd_diff    = pid->Kd * pid->inv_ts;
+    pid->kd_filter  = pid->Kd * pid->d_filter_scale;
+}
+
+/* 刷新预计算系数：所有除法集中在这里完成，update 热路径只剩乘加 */
+static void pid_update_coefficients(PIDController* pid)
+{
+    pid->half_ts = 0.5f * pid->Ts;
+    pid->inv_ts  = 1.0f / pid->Ts;
+    if (pid->tau > 0.0f)
+    {
+        pid->alpha          = (2.0f * pid->tau - pid->Ts) / (2.0f * pid->tau + pid->Ts);
+        pid->d_filter_scale = 2.0f / ((2.0f * pid->tau + pid->Ts) * pid->Ts);
+    }
+    else
+    {
+        pid->alpha          = 0.0f;
+        pid->d_filter_scale = 0.0f;
+    }
+    pid->kaw_ts = pid->Kaw * pid->Ts;
+    pid_update_gain_coefficients(pid);
+}
+
 /* 初始化 PID */
 void pid_init(PIDController* pid, float Kp, float Ki, float Kd, float Ts, float out_min,
               float out_max, float tau)
@@ -35,6 +62,13 @@ void pid_init(PIDController* pid, float Kp, float Ki, float Kd, float Ts, float
     pid->prev_measurement = 0.0f;
     pid->differentiator   = 0.0f;
     pid->tau              = tau; // 推荐 tau 在 0.01*Ts 到 10*Ts 之间尝试
+    pid->b                = 1.0f;
+    pid->c                = tau > 0.0f ? 0.0f : 1.0f; // 与未加权时的微分形式保持一致
+    pid->anti_windup      = PID_AW_UNDO;
+    pid->Kaw              = 0.0f;
+    pid->integ_min        = out_min;
+    pid->integ_max        = out_max;
+    pid_update_coefficients(pid);
 }
 
 void pid_reset(PIDController* pid)
@@ -53,53 +87,144 @@ static float clampf(float v, float lo, float hi)
         return hi;
     return v;
 }
+/* 运行中修改增益：把比例项的变化量折算进积分器，保证输出连续（无扰切换） */
+void pid_set_gains(PIDController* pid, float Kp, float Ki, float Kd)
+{
+    // 上一拍输出 P = Kp_old * (b*r - y)，新增益下 P = Kp_new * (b*r - y)，差值由积分器吸收
+    // 其中 b*r - y = b*e + (b - 1)*y
+    float p_input = pid->b * pid->prev_error + (pid->b - 1.0f) * pid->prev_measurement;
+    pid->integrator += (pid->Kp - Kp) * p_input;
+    pid->integrator = clampf(pid->integrator, pid->integ_min, pid->integ_max);
+    // 积分器和微分器状态保存的都是输出量纲，修改 Ki / Kd 不会引起跳变
+    pid->Kp = Kp;
+    pid->Ki = Ki;
+    pid->Kd = Kd;
+    pid_update_gain_coefficients(pid);
+}
+/* 运行中修改采样周期和微分滤波时间常数 */
+void pid_set_sample_time(PIDController* pid, float Ts, float tau)
+{
+    pid->Ts  = Ts;
+    pid->tau = tau;
+    pid_update_coefficients(pid);
+}
+/* 选择积分抗饱和策略 */
+void pid_set_anti_windup(PIDController* pid, PIDAntiWindup mode, float Kaw, float integ_min,
+                         float integ_max)
+{
+    pid->anti_windup = mode;
+    pid->Kaw         = Kaw;
+    pid->kaw_ts      = Kaw * pid->Ts;
+    pid->integ_min   = integ_min;
+    pid->integ_max   = integ_max;
+    pid->integrator  = clampf(pid->integrator, integ_min, integ_max);
+}
+/* 设置二自由度设定值权重：b 减小设定值阶跃引起的比例冲击，c = 0 时微分只作用于测量值 */
+void pid_set_setpoint_weights(PIDController* pid, float b, float c)
+{
+    // 修改 b 会改变比例项输入，按 pid_set_gains 同样的方式由积分器吸收差值
+    pid->integrator += pid->Kp * (pid->b - b) * (pid->prev_error + pid->prev_measurement);
+    pid->integrator = clampf(pid->integrator, pid->integ_min, pid->integ_max);
+    pid->b          = b;
+    pid->c          = c;
+}
 /* PID 核心更新：传入设定值和测量值，返回控制量 */
 float pid_update(PIDController* pid, float setpoint, float measurement)
+{
+    return pid_update_ff(pid, setpoint, measurement, 0.0f);
+}
+/* PID 核心更新：dt_scale 为实际经过的时间与标称 Ts 之比，inv_dt_scale 为其倒数
+ * 积分步长和反算法系数乘 dt_scale，微分输入（差分 / Ts）乘 inv_dt_scale，
+ * 标称周期下两者都为 1，内联后乘 1 被编译器消去 */
+static inline float pid_update_scaled(PIDController* pid, float setpoint, float measurement,
+                                      float feedforward, float dt_scale, float inv_dt_scale)
 {
     float error = setpoint - measurement;
-    // 比例项
-    float P = pid->Kp * error;
-    // 积分项（矩形积分）
-    pid->integrator += 0.5f * pid->Ki * pid->Ts * (error + pid->prev_error);
+    // 比例项（设定值加权：b*r - y = b*e + (b - 1)*y，b = 1 时即为 e）
+    float P = pid->Kp * (pid->b * error + (pid->b - 1.0f) * measurement);
+    // 积分项（梯形积分），系数 0.5*Ki*Ts 已预先计算
+    float integ_step = pid->ki_half_ts * dt_scale * (error + pid->prev_error);
+    pid->integrator += integ_step;
     // 积分防风（限制积分值，避免积分累积过大）
-    // 可将积分范围设为输出范围的一部分，或单独配置
-    float integ_min = pid->out_min;
-    float integ_max = pid->out_max;
-    pid->integrator = clampf(pid->integrator, integ_min, integ_max);
+    // 积分范围默认等于输出范围，可通过 pid_set_anti_windup 单独配置
+    pid->integrator = clampf(pid->integrator, pid->integ_min, pid->integ_max);
     float I         = pid->integrator;
     // 微分项（使用测量值微分 + 一阶低通滤波，减少噪声放大）
     // differentiator 状态使用滤波器： D = ( -Kd * (measurement - prev_measurement) * (1/Ts) )
     // filtered 使用标准形式： differentiator = (2*tau - Ts)/(2*tau + Ts) * differentiator_prev
-    //    - 2*Kd/(2*tau + Ts) * (measurement - prev_measurement)
+    //    - 2*Kd/(2*tau + Ts) * (measurement - prev_measurement) / Ts
+    // 其中 alpha 和 kd_filter 已在 pid_update_coefficients 中预先计算
+    // 微分输入为 c*r - y，其增量 = c*(e - e_prev) - (1 - c)*(y - y_prev)
+    // c = 0 时即测量值微分，能减少 setpoint step 导致的 D 爆炸（常见做法）；c = 1 时即误差微分
+    float d_delta = (pid->c * (error - pid->prev_error) -
+                     (1.0f - pid->c) * (measurement - pid->prev_measurement)) *
+                    inv_dt_scale;
     if (pid->tau <= 0.0f)
     {
         // 没有滤波，简单差分
-        pid->differentiator = pid->Kd * (error - pid->prev_error) / pid->Ts;
+        pid->differentiator = pid->kd_diff * d_delta;
     }
     else
     {
-        float alpha        = (2.0f * pid->tau - pid->Ts) / (2.0f * pid->tau + pid->Ts);
-        float diff_measure = (measurement - pid->prev_measurement) / pid->Ts;
-        // 用 measurement 上的微分能减少 setpoint step 导致的 D 爆炸（常见做法）
-        pid->differentiator = alpha * pid->differentiator -
-                              (2.0f * pid->Kd / (2.0f * pid->tau + pid->Ts)) * diff_measure;
+        pid->differentiator = pid->alpha * pid->differentiator + pid->kd_filter * d_delta;
     }
     float D = pid->differentiator;
-    // 合并输出并限幅
-    float output         = P + I + D;
+    // 合并输出（含前馈）并限幅
+    float output         = P + I + D + feedforward;
     float output_clamped = clampf(output, pid->out_min, pid->out_max);
-    // 抗积分风（simple back-calculation）：如果输出被限幅，减小积分（选项）
-    // 若输出 被限幅 且 与未限幅输出有差异，则按差异调整积分（更稳定）
-    // 下面是一个简单的实现：当限幅时，撤销刚才的积分累加量
-    if (output != output_clamped)
+    // 抗积分风：按 anti_windup 选择的策略处理输出饱和
+    switch (pid->anti_windup)
     {
-        // 取消本次积分（另一种方法是使用反向补偿 gain）
-        pid->integrator -= 0.5f * pid->Ki * pid->Ts * (error + pid->prev_error);
-        I = pid->integrator;
-        // 可考虑更复杂的反向补偿法： integrator += (output_clamped - output) * K_aw
+    case PID_AW_BACK_CALCULATION:
+        // 反算法：按限幅前后输出之差持续把积分器拉回，饱和越深回拉越快
+        pid->integrator += pid->kaw_ts * dt_scale * (output_clamped - output);
+        pid->integrator = clampf(pid->integrator, pid->integ_min, pid->integ_max);
+        break;
+    case PID_AW_CONDITIONAL:
+        // 条件积分：输出饱和且误差与饱和方向相同时，本拍不积分；误差反向时照常积分以尽快退出饱和
+        if ((output > pid->out_max && error > 0.0f) || (output < pid->out_min && error < 0.0f))
+        {
+            pid->integrator -= integ_step;
+        }
+        break;
+    case PID_AW_CLAMP:
+        // 仅依赖上面的积分器范围限制
+        break;
+    case PID_AW_UNDO:
+    default:
+        // 当限幅时，撤销刚才的积分累加量
+        if (output != output_clamped)
+        {
+            pid->integrator -= integ_step;
+        }
+        break;
     }
     // 更新历史值
     pid->prev_error       = error;
     pid->prev_measurement = measurement;
     return output_clamped;
-}
\ No newline at end of file
+}
+/* PID 核心更新（带前馈）：传入设定值、测量值和前馈量，返回控制量 */
+float pid_update_ff(PIDController* pid, float setpoint, float measurement, float feedforward)
+{
+    return pid_update_scaled(pid, setpoint, measurement, feedforward, 1.0f, 1.0f);
+}
+/* PID 更新（实测采样间隔）：积分和微分按实际经过的时间计算 */
+float pid_update_dt(PIDController* pid, float setpoint, float measurement, float dt)
+{
+    return pid_update_ff_dt(pid, setpoint, measurement, 0.0f, dt);
+}
+/* PID 更新（实测采样间隔，带前馈）
+ * 标称 Ts 和预计算系数保持不变，只按 dt / Ts 缩放本拍的积分和微分项：
+ * 偏差在 PID_DT_TOLERANCE 以内时按标称周期计算，超出时只多一次乘法和一次求倒数。
+ * 滤波系数 alpha 仍按标称 Ts，偶发的长短周期只让微分低通的时间常数在这一拍略有偏差 */
+float pid_update_ff_dt(PIDController* pid, float setpoint, float measurement, float feedforward,
+                       float dt)
+{
+    float dt_scale = dt * pid->inv_ts;
+    if (dt <= 0.0f || (dt_scale < 1.0f + PID_DT_TOLERANCE && dt_scale > 1.0f - PID_DT_TOLERANCE))
+    {
+        return pid_update_ff(pid, setpoint, measurement, feedforward);
+    }
+    return pid_update_scaled(pid, setpoint, measurement, feedforward, dt_scale, 1.0f / dt_scale);
+}
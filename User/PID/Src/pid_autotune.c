@@ -0,0 +1,137 @@
+/**
+ * @file    pid_autotune.c
+ * @brief   继电反馈 PID 自整定实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了 Åström–Hägglund 继电反馈自整定的实现。
+ *          用带滞环的继电器（bang-bang）代替控制器，使闭环形成极限环振荡，
+ *          测量振荡幅值 a 和周期 Pu，由描述函数得到临界增益 Ku = 4d / (π·sqrt(a² - ε²))，
+ *          再按 Ziegler–Nichols 或 Tyreus–Luyben 规则换算 PID 参数。
+ *          pid_autotune_update 每个采样节拍只做比较和加法，可以放在定时器中断里运行。
+ *
+ * @note    第一个振荡周期包含起振过渡过程，不参与平均。不依赖 HAL。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_autotune.h"
+#include <math.h>
+
+#define PID_AUTOTUNE_PI 3.14159265f
+
+void pid_autotune_init(PIDAutotune* tune, float setpoint, float bias, float amplitude,
+                       float hysteresis, float Ts, uint32_t max_ticks, uint8_t cycles)
+{
+    tune->setpoint      = setpoint;
+    tune->bias          = bias;
+    tune->amplitude     = amplitude;
+    tune->hysteresis    = hysteresis;
+    tune->Ts            = Ts;
+    tune->max_ticks     = max_ticks;
+    tune->cycles        = cycles > 0 ? cycles : 1;
+    tune->state         = PID_AUTOTUNE_RUNNING;
+    tune->relay         = 1;
+    tune->tick          = 0;
+    tune->last_rise     = 0;
+    tune->rises         = 0;
+    tune->peak_max      = setpoint;
+    tune->peak_min      = setpoint;
+    tune->amplitude_sum = 0.0f;
+    tune->period_sum    = 0.0f;
+    tune->Ku            = 0.0f;
+    tune->Pu            = 0.0f;
+}
+
+/* 完成一次完整振荡周期后的统计，返回1表示已采集足够周期 */
+static uint8_t pid_autotune_cycle_done(PIDAutotune* tune, float measurement)
+{
+    // 第一次上升沿只作为计时起点，第二次上升沿对应的是起振过渡周期，均不统计
+    if (tune->rises >= 3)
+    {
+        tune->amplitude_sum += 0.5f * (tune->peak_max - tune->peak_min);
+        tune->period_sum += (tune->tick - tune->last_rise) * tune->Ts;
+    }
+    tune->last_rise = tune->tick;
+    tune->peak_max  = measurement;
+    tune->peak_min  = measurement;
+    return tune->rises >= 2 + tune->cycles;
+}
+
+float pid_autotune_update(PIDAutotune* tune, float measurement)
+{
+    if (tune->state != PID_AUTOTUNE_RUNNING)
+    {
+        return 0.0f;
+    }
+
+    tune->tick++;
+    if (measurement > tune->peak_max)
+        tune->peak_max = measurement;
+    if (measurement < tune->peak_min)
+        tune->peak_min = measurement;
+
+    // 带滞环的继电器：误差越过 ±ε 才切换方向
+    if (tune->relay > 0 && measurement > tune->setpoint + tune->hysteresis)
+    {
+        tune->relay = -1;
+    }
+    else if (tune->relay < 0 && measurement < tune->setpoint - tune->hysteresis)
+    {
+        tune->relay = 1;
+        tune->rises++;
+        if (pid_autotune_cycle_done(tune, measurement))
+        {
+            float a  = tune->amplitude_sum / tune->cycles;
+            float a2 = a * a - tune->hysteresis * tune->hysteresis;
+            if (a2 <= 0.0f)
+            {
+                // 振荡幅值没有超出滞环，继电器增益过小
+                tune->state = PID_AUTOTUNE_FAILED;
+                return 0.0f;
+            }
+            tune->Ku    = 4.0f * tune->amplitude / (PID_AUTOTUNE_PI * sqrtf(a2));
+            tune->Pu    = tune->period_sum / tune->cycles;
+            tune->state = PID_AUTOTUNE_DONE;
+            return 0.0f;
+        }
+    }
+
+    if (tune->tick >= tune->max_ticks)
+    {
+        tune->state = PID_AUTOTUNE_FAILED;
+        return 0.0f;
+    }
+
+    return tune->bias + tune->relay * tune->amplitude;
+}
+
+uint8_t pid_autotune_gains(const PIDAutotune* tune, PIDTuneRule rule, float* Kp, float* Ki,
+                           float* Kd)
+{
+    if (tune->state != PID_AUTOTUNE_DONE)
+    {
+        return 0;
+    }
+
+    float Ti, Td;
+    switch (rule)
+    {
+    case PID_TUNE_TYREUS_LUYBEN:
+        *Kp = tune->Ku / 2.2f;
+        Ti  = 2.2f * tune->Pu;
+        Td  = tune->Pu / 6.3f;
+        break;
+    case PID_TUNE_ZIEGLER_NICHOLS:
+    default:
+        *Kp = 0.6f * tune->Ku;
+        Ti  = 0.5f * tune->Pu;
+        Td  = 0.125f * tune->Pu;
+        break;
+    }
+    // pid_update 中积分项为 Ki * ∫e dt，微分项为 Kd * de/dt
+    *Ki = *Kp / Ti;
+    *Kd = *Kp * Td;
+    return 1;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file    pid_bank.c
+ * @brief   多回路 PID 控制器组实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了多回路 PID 控制器组的实现。
+ *          每个字段按回路存放在连续数组中（数组结构体布局），
+ *          pid_bank_update 一次顺序扫描所有回路，访存连续、没有按回路的分支，
+ *          便于编译器展开和硬件预取。算法与 pid_update 逐项一致。
+ *
+ * @note    不依赖 HAL，不使用堆内存，可直接在 PC 上编译。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_bank.h"
+
+/* 限幅辅助 */
+static inline float clampf(float v, float lo, float hi)
+{
+    if (v < lo)
+        return lo;
+    if (v > hi)
+        return hi;
+    return v;
+}
+
+/* 刷新某个回路的预计算系数，tau 是否大于 0 的分支也在这里消除 */
+static void pid_bank_update_coefficients(PIDBank* bank, uint8_t i)
+{
+    float Ts            = bank->Ts[i];
+    float tau           = bank->tau[i];
+    bank->ki_half_ts[i] = 0.5f * bank->Ki[i] * Ts;
+    if (tau > 0.0f)
+    {
+        bank->kd_diff[i]   = 0.0f;
+        bank->alpha[i]     = (2.0f * tau - Ts) / (2.0f * tau + Ts);
+        bank->kd_filter[i] = 2.0f * bank->Kd[i] / ((2.0f * tau + Ts) * Ts);
+    }
+    else
+    {
+        bank->kd_diff[i]   = bank->Kd[i] / Ts;
+        bank->alpha[i]     = 0.0f;
+        bank->kd_filter[i] = 0.0f;
+    }
+}
+
+void pid_bank_init(PIDBank* bank)
+{
+    bank->count = 0;
+}
+
+int pid_bank_add(PIDBank* bank, float Kp, float Ki, float Kd, float Ts, float out_min,
+                 float out_max, float tau)
+{
+    if (bank->count >= PID_BANK_MAX_LOOPS)
+    {
+        return -1;
+    }
+    uint8_t i                 = bank->count;
+    bank->Kp[i]               = Kp;
+    bank->Ki[i]               = Ki;
+    bank->Kd[i]               = Kd;
+    bank->Ts[i]               = Ts;
+    bank->tau[i]              = tau;
+    bank->out_min[i]          = out_min;
+    bank->out_max[i]          = out_max;
+    bank->integrator[i]       = 0.0f;
+    bank->prev_error[i]       = 0.0f;
+    bank->prev_measurement[i] = 0.0f;
+    bank->differentiator[i]   = 0.0f;
+    pid_bank_update_coefficients(bank, i);
+    bank->count++;
+    return i;
+}
+
+void pid_bank_set_gains(PIDBank* bank, uint8_t index, float Kp, float Ki, float Kd)
+{
+    if (index >= bank->count)
+    {
+        return;
+    }
+    // 与 pid_set_gains 相同：比例项变化量由积分器吸收
+    bank->integrator[index] += (bank->Kp[index] - Kp) * bank->prev_error[index];
+    bank->integrator[index] =
+        clampf(bank->integrator[index], bank->out_min[index], bank->out_max[index]);
+    bank->Kp[index] = Kp;
+    bank->Ki[index] = Ki;
+    bank->Kd[index] = Kd;
+    pid_bank_update_coefficients(bank, index);
+}
+
+void pid_bank_reset(PIDBank* bank)
+{
+    for (uint8_t i = 0; i < bank->count; i++)
+    {
+        bank->integrator[i]       = 0.0f;
+        bank->prev_error[i]       = 0.0f;
+        bank->prev_measurement[i] = 0.0f;
+        bank->differentiator[i]   = 0.0f;
+    }
+}
+
+/* 批量更新：所有回路顺序处理，循环体内只有乘加和限幅 */
+void pid_bank_update(PIDBank* bank, const float* setpoints, const float* measurements,
+                     float* outputs)
+{
+    uint8_t n = bank->count;
+    for (uint8_t i = 0; i < n; i++)
+    {
+        float measurement = measurements[i];
+        float error       = setpoints[i] - measurement;
+        float prev_error  = bank->prev_error[i];
+        // 比例项
+        float P = bank->Kp[i] * error;
+        // 积分项（梯形积分）+ 积分防风
+        float integ_step = bank->ki_half_ts[i] * (error + prev_error);
+        float I = clampf(bank->integrator[i] + integ_step, bank->out_min[i], bank->out_max[i]);
+        // 微分项：tau > 0 时 kd_diff 为 0，否则 alpha 和 kd_filter 为 0
+        float D = bank->alpha[i] * bank->differentiator[i] -
+                  bank->kd_filter[i] * (measurement - bank->prev_measurement[i]) +
+                  bank->kd_diff[i] * (error - prev_error);
+        // 合并输出并限幅
+        float output         = P + I + D;
+        float output_clamped = clampf(output, bank->out_min[i], bank->out_max[i]);
+        // 抗积分风：输出被限幅时撤销本次积分累加量
+        if (output != output_clamped)
+        {
+            I -= integ_step;
+        }
+        // 写回状态
+        bank->integrator[i]       = I;
+        bank->differentiator[i]   = D;
+        bank->prev_error[i]       = error;
+        bank->prev_measurement[i] = measurement;
+        outputs[i]                = output_clamped;
+    }
+}
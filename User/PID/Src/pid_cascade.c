@@ -0,0 +1,68 @@
+/**
+ * @file    pid_cascade.c
+ * @brief   串级（位置 -> 速度）PID 控制器实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了串级 PID 控制器的实现。
+ *          外环根据位置误差给出速度设定值，内环根据速度误差给出执行器控制量。
+ *          两个回路在同一个基础节拍（TIM2 中断）上按各自的分频运行，外环通常更慢。
+ *          内环输出饱和时，外环停止向饱和方向积分，避免外环积分饱和导致位置超调。
+ *
+ * @note    不依赖 HAL，可在 PC 上用仿真对象验证。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_cascade.h"
+
+void pid_cascade_init(PIDCascade* cascade, PIDController* outer, PIDController* inner,
+                      uint8_t outer_divider, uint8_t inner_divider)
+{
+    cascade->outer         = outer;
+    cascade->inner         = inner;
+    cascade->outer_divider = outer_divider > 0 ? outer_divider : 1;
+    cascade->inner_divider = inner_divider > 0 ? inner_divider : 1;
+    pid_cascade_reset(cascade);
+}
+
+void pid_cascade_reset(PIDCascade* cascade)
+{
+    pid_reset(cascade->outer);
+    pid_reset(cascade->inner);
+    cascade->tick           = 0;
+    cascade->speed_setpoint = 0.0f;
+    cascade->output         = 0.0f;
+}
+
+float pid_cascade_update(PIDCascade* cascade, float position_setpoint, float position,
+                         float speed)
+{
+    // 外环：位置 -> 速度设定值
+    if (cascade->tick % cascade->outer_divider == 0)
+    {
+        float integrator_prev   = cascade->outer->integrator;
+        cascade->speed_setpoint = pid_update(cascade->outer, position_setpoint, position);
+        // 内环已饱和时，外环积分不再向同一方向累积（内环饱和反馈到外环抗积分风）
+        if ((cascade->output >= cascade->inner->out_max &&
+             cascade->outer->integrator > integrator_prev) ||
+            (cascade->output <= cascade->inner->out_min &&
+             cascade->outer->integrator < integrator_prev))
+        {
+            cascade->outer->integrator = integrator_prev;
+        }
+    }
+    // 内环：速度 -> 执行器控制量
+    if (cascade->tick % cascade->inner_divider == 0)
+    {
+        cascade->output = pid_update(cascade->inner, cascade->speed_setpoint, speed);
+    }
+    // 两个分频的公倍数处回绕，避免计数溢出后节拍错位
+    cascade->tick++;
+    if (cascade->tick >= cascade->outer_divider * cascade->inner_divider)
+    {
+        cascade->tick = 0;
+    }
+    return cascade->output;
+}
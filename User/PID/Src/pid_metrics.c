@@ -0,0 +1,102 @@
+/**
+ * @file    pid_metrics.c
+ * @brief   阶跃响应指标统计实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了阶跃响应指标的在线统计：上升时间（10% -> 90%）、超调量、调节时间、
+ *          IAE / ISE / ITAE 误差积分以及执行器饱和占空比。
+ *          响应先按阶跃幅值归一化，正反向阶跃使用同一套判据。
+ *          每个节拍只做常数次比较和乘加，既可以在 PC 上配合 pid_plant 做回归，
+ *          也可以直接放在定时器中断里统计实物的响应。
+ *
+ * @note    调节时间记录的是最后一次处于误差带外的时刻，统计结束前仍可能变大。不依赖 HAL。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_metrics.h"
+#include <math.h>
+
+void pid_metrics_init(PIDMetrics* metrics, float initial, float setpoint, float band, float Ts)
+{
+    float step               = setpoint - initial;
+    metrics->initial         = initial;
+    metrics->setpoint        = setpoint;
+    metrics->band            = band;
+    metrics->Ts              = Ts;
+    metrics->inv_step        = step != 0.0f ? 1.0f / step : 0.0f;
+    metrics->tick            = 0;
+    metrics->rise_start      = 0;
+    metrics->rise_end        = 0;
+    metrics->settle_tick     = 0;
+    metrics->saturated_ticks = 0;
+    metrics->peak            = 0.0f;
+    metrics->iae             = 0.0f;
+    metrics->ise             = 0.0f;
+    metrics->itae            = 0.0f;
+}
+
+void pid_metrics_update(PIDMetrics* metrics, float measurement, uint8_t saturated)
+{
+    metrics->tick++;
+    float error        = metrics->setpoint - measurement;
+    float abs_error_dt = fabsf(error) * metrics->Ts;
+    // 误差积分（矩形积分），ITAE 的时间取本节拍结束时刻
+    metrics->iae += abs_error_dt;
+    metrics->ise += error * error * metrics->Ts;
+    metrics->itae += metrics->tick * metrics->Ts * abs_error_dt;
+    if (saturated)
+    {
+        metrics->saturated_ticks++;
+    }
+
+    // 归一化响应：0 为阶跃前，1 为设定值
+    float progress = (measurement - metrics->initial) * metrics->inv_step;
+    if (progress > metrics->peak)
+    {
+        metrics->peak = progress;
+    }
+    if (metrics->rise_start == 0 && progress >= 0.1f)
+    {
+        metrics->rise_start = metrics->tick;
+    }
+    if (metrics->rise_end == 0 && progress >= 0.9f)
+    {
+        metrics->rise_end = metrics->tick;
+    }
+    // 归一化误差 1 - progress 超出误差带时，调节时间推迟到本节拍
+    if (fabsf(1.0f - progress) > metrics->band)
+    {
+        metrics->settle_tick = metrics->tick;
+    }
+}
+
+float pid_metrics_rise_time(const PIDMetrics* metrics)
+{
+    if (metrics->rise_end == 0)
+    {
+        return -1.0f;
+    }
+    return (metrics->rise_end - metrics->rise_start) * metrics->Ts;
+}
+
+float pid_metrics_overshoot(const PIDMetrics* metrics)
+{
+    return metrics->peak > 1.0f ? (metrics->peak - 1.0f) * 100.0f : 0.0f;
+}
+
+float pid_metrics_settling_time(const PIDMetrics* metrics)
+{
+    return metrics->settle_tick * metrics->Ts;
+}
+
+float pid_metrics_saturation_duty(const PIDMetrics* metrics)
+{
+    if (metrics->tick == 0)
+    {
+        return 0.0f;
+    }
+    return 100.0f * metrics->saturated_ticks / metrics->tick;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file    pid_plant.c
+ * @brief   被控对象仿真模型实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了用于离线验证控制器的被控对象模型：
+ *          1. 一阶惯性加纯滞后（FOPDT）：按零阶保持精确离散化，纯滞后用环形缓冲区实现；
+ *          2. 带减速器的直流电机：电枢回路和机械回路两个状态，半隐式欧拉法按子步积分，
+ *             电流取隐式更新，电气时间常数远小于采样周期时也不会发散；
+ *          3. 编码器量化：把电机轴连续转角截断为整数计数，复现低速时的测速量化噪声。
+ *          与 pid_metrics 配合，可以在 PC 上对各控制器变体做阶跃响应回归。
+ *
+ * @note    不依赖 HAL，只使用 math.h。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_plant.h"
+#include <math.h>
+
+#define PID_PLANT_TWO_PI 6.28318531f
+
+void pid_plant_fopdt_init(PIDPlantFOPDT* plant, float gain, float tau, float dead_time, float Ts)
+{
+    plant->gain  = gain;
+    plant->alpha = tau > 0.0f ? expf(-Ts / tau) : 0.0f;
+    int delay    = (int)(dead_time / Ts + 0.5f);
+    if (delay < 0)
+        delay = 0;
+    if (delay > PID_PLANT_MAX_DELAY)
+        delay = PID_PLANT_MAX_DELAY;
+    plant->delay  = (uint8_t)delay;
+    plant->head   = 0;
+    plant->output = 0.0f;
+    for (uint8_t i = 0; i < PID_PLANT_MAX_DELAY; i++)
+    {
+        plant->buffer[i] = 0.0f;
+    }
+}
+
+float pid_plant_fopdt_step(PIDPlantFOPDT* plant, float input)
+{
+    float delayed = input;
+    if (plant->delay > 0)
+    {
+        // 取出 delay 拍之前的输入，再写入本拍输入
+        delayed                    = plant->buffer[plant->head];
+        plant->buffer[plant->head] = input;
+        plant->head++;
+        if (plant->head >= plant->delay)
+        {
+            plant->head = 0;
+        }
+    }
+    plant->output = plant->alpha * plant->output + (1.0f - plant->alpha) * plant->gain * delayed;
+    return plant->output;
+}
+
+void pid_plant_dc_motor_init(PIDPlantDCMotor* motor, float R, float L, float Ke, float Kt, float J,
+                             float b, float gear_ratio, float Ts, uint8_t substeps)
+{
+    motor->R          = R;
+    motor->L          = L;
+    motor->Ke         = Ke;
+    motor->Kt         = Kt;
+    motor->J          = J;
+    motor->b          = b;
+    motor->gear_ratio = gear_ratio;
+    motor->substeps   = substeps > 0 ? substeps : 1;
+    motor->h          = Ts / motor->substeps;
+    motor->current    = 0.0f;
+    motor->omega      = 0.0f;
+    motor->angle      = 0.0f;
+}
+
+float pid_plant_dc_motor_step(PIDPlantDCMotor* motor, float voltage, float load_torque)
+{
+    float h = motor->h;
+    for (uint8_t i = 0; i < motor->substeps; i++)
+    {
+        // 半隐式欧拉：电流按隐式欧拉更新（电气时间常数远小于步长时也稳定），再用新电流更新转速
+        motor->current = (motor->current + h * (voltage - motor->Ke * motor->omega) / motor->L) /
+                         (1.0f + h * motor->R / motor->L);
+        motor->omega +=
+            h * (motor->Kt * motor->current - motor->b * motor->omega - load_torque) / motor->J;
+        motor->angle += h * motor->omega / PID_PLANT_TWO_PI;
+    }
+    // 电机轴 rad/s -> 输出轴 转/分
+    return motor->omega * 60.0f / (PID_PLANT_TWO_PI * motor->gear_ratio);
+}
+
+void pid_plant_encoder_init(PIDPlantEncoder* encoder, float counts_per_rev, float angle)
+{
+    encoder->counts_per_rev = counts_per_rev;
+    encoder->last_count     = (int32_t)floorf(angle * counts_per_rev);
+}
+
+int32_t pid_plant_encoder_read(PIDPlantEncoder* encoder, float angle)
+{
+    int32_t count       = (int32_t)floorf(angle * encoder->counts_per_rev);
+    int32_t diff        = count - encoder->last_count;
+    encoder->last_count = count;
+    return diff;
+}
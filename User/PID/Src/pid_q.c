@@ -0,0 +1,160 @@
+/**
+ * @file    pid_q.c
+ * @brief   Q16.16 定点 PID 控制器实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了与 pid.c 行为一致的定点 PID 控制器实现。
+ *          STM32F103 没有 FPU，浮点版本在中断中需要调用大量软浮点库函数；
+ *          定点版本只使用 32x32->64 位整数乘法（Cortex-M3 单条 SMULL 指令）和移位，
+ *          所有除法都在 pid_q_init 中预先完成。
+ *          包含测量值微分低通滤波、输出限幅和积分防风，算法与 pid_update 逐项对应。
+ *          系数不用统一的 Q16.16：采样率较高时 0.5*Ki*Ts 只有几个 LSB，Kd/Ts 又会超过 32768，
+ *          因此每个系数各存一个 30 位尾数和右移位数，乘法后按各自的位数移位。
+ *          积分器多保留 PID_Q_INTEG_EXTRA_BITS 位小数，每拍很小的积分增量不会被舍入掉。
+ *
+ * @note    信号（设定值、测量值、输出）为 Q16.16，表示范围为 [-32768, 32767.99998]，
+ *          中间结果溢出时做饱和处理。
+ *          本文件不依赖 HAL，可直接在 PC 上编译，与 pid.c 对比输出（见 test/test_pid_q.c）。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_q.h"
+#include <math.h>
+
+/* 将 64 位中间结果饱和到 Q16.16 范围 */
+static inline q16_t q16_sat(int64_t v)
+{
+    if (v > Q16_MAX)
+        return Q16_MAX;
+    if (v < Q16_MIN)
+        return Q16_MIN;
+    return (q16_t)v;
+}
+
+/* 系数乘法（四舍五入）：|mant| < 2^30、|x| < 2^33，乘积和舍入量都不会溢出 64 位 */
+static inline int64_t pid_q_mul(PIDQCoef c, int64_t x)
+{
+    int64_t product = (int64_t)c.mant * x;
+    if (c.shift == 0)
+    {
+        return product;
+    }
+    return (product + ((int64_t)1 << (c.shift - 1))) >> c.shift;
+}
+
+/* 限幅辅助 */
+static inline q16_t clampq(q16_t v, q16_t lo, q16_t hi)
+{
+    if (v < lo)
+        return lo;
+    if (v > hi)
+        return hi;
+    return v;
+}
+
+/* 浮点系数换算为尾数和右移位数（只在初始化时调用） */
+static PIDQCoef pid_q_coef(float x)
+{
+    PIDQCoef c = {0, 0};
+    if (x == 0.0f)
+    {
+        return c;
+    }
+    // x = m * 2^exponent，0.5 <= |m| < 1；float 只有 24 位尾数，放进 30 位尾数没有舍入
+    int exponent;
+    float m   = frexpf(x, &exponent);
+    int shift = PID_Q_COEF_BITS - exponent;
+    if (shift < 0)
+    {
+        // 系数不小于 2^30，饱和
+        c.mant = x > 0.0f ? (1L << PID_Q_COEF_BITS) - 1 : -((1L << PID_Q_COEF_BITS) - 1);
+        return c;
+    }
+    if (shift > 62)
+    {
+        // 系数过小，尾数相应变短
+        m     = ldexpf(m, 62 - shift);
+        shift = 62;
+    }
+    c.mant  = (int32_t)lroundf(ldexpf(m, PID_Q_COEF_BITS));
+    c.shift = (uint8_t)shift;
+    return c;
+}
+
+/* 初始化定点 PID：所有除法在这里用浮点一次性完成 */
+void pid_q_init(PIDControllerQ* pid, float Kp, float Ki, float Kd, float Ts, float out_min,
+                float out_max, float tau)
+{
+    pid->Kp         = pid_q_coef(Kp);
+    pid->ki_half_ts = pid_q_coef(ldexpf(0.5f * Ki * Ts, PID_Q_INTEG_EXTRA_BITS));
+    pid->out_min    = Q16_FROM_FLOAT(out_min);
+    pid->out_max    = Q16_FROM_FLOAT(out_max);
+    if (tau <= 0.0f)
+    {
+        pid->use_filter = 0;
+        pid->kd_diff    = pid_q_coef(Kd / Ts);
+        pid->alpha      = pid_q_coef(0.0f);
+        pid->kd_filter  = pid_q_coef(0.0f);
+    }
+    else
+    {
+        pid->use_filter = 1;
+        pid->kd_diff    = pid_q_coef(0.0f);
+        pid->alpha      = pid_q_coef((2.0f * tau - Ts) / (2.0f * tau + Ts));
+        pid->kd_filter  = pid_q_coef(2.0f * Kd / ((2.0f * tau + Ts) * Ts));
+    }
+    pid_q_reset(pid);
+}
+
+void pid_q_reset(PIDControllerQ* pid)
+{
+    pid->integrator       = 0;
+    pid->prev_error       = 0;
+    pid->prev_measurement = 0;
+    pid->differentiator   = 0;
+}
+
+/* 定点 PID 核心更新：与 pid_update 逐项对应 */
+q16_t pid_q_update(PIDControllerQ* pid, q16_t setpoint, q16_t measurement)
+{
+    q16_t error = q16_sat((int64_t)setpoint - measurement);
+    // 比例项
+    q16_t P = q16_sat(pid_q_mul(pid->Kp, error));
+    // 积分项（梯形积分），积分器和积分增量都带 PID_Q_INTEG_EXTRA_BITS 位额外小数
+    int64_t integ_step = pid_q_mul(pid->ki_half_ts, (int64_t)error + pid->prev_error);
+    int64_t integ_min  = (int64_t)pid->out_min << PID_Q_INTEG_EXTRA_BITS;
+    int64_t integ_max  = (int64_t)pid->out_max << PID_Q_INTEG_EXTRA_BITS;
+    pid->integrator += integ_step;
+    if (pid->integrator < integ_min)
+        pid->integrator = integ_min;
+    if (pid->integrator > integ_max)
+        pid->integrator = integ_max;
+    q16_t I = (q16_t)((pid->integrator + (1 << (PID_Q_INTEG_EXTRA_BITS - 1))) >>
+                      PID_Q_INTEG_EXTRA_BITS);
+    // 微分项（测量值微分 + 一阶低通滤波），Kd / Ts 很大时乘积饱和而不是回绕
+    if (pid->use_filter == 0)
+    {
+        pid->differentiator = q16_sat(pid_q_mul(pid->kd_diff, (int64_t)error - pid->prev_error));
+    }
+    else
+    {
+        pid->differentiator =
+            q16_sat(pid_q_mul(pid->alpha, pid->differentiator) -
+                    pid_q_mul(pid->kd_filter, (int64_t)measurement - pid->prev_measurement));
+    }
+    // 合并输出并限幅
+    int64_t output       = (int64_t)P + I + pid->differentiator;
+    q16_t output_clamped = clampq(q16_sat(output), pid->out_min, pid->out_max);
+    // 抗积分风：输出被限幅时撤销本次积分累加量
+    if (output != output_clamped)
+    {
+        pid->integrator -= integ_step;
+    }
+    // 更新历史值
+    pid->prev_error       = error;
+    pid->prev_measurement = measurement;
+    return output_clamped;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file    pid_rls.c
+ * @brief   一阶对象模型递推最小二乘辨识实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了带遗忘因子的递推最小二乘（RLS）辨识器的实现。
+ *          回归向量 φ = [y[k-1], u[k-1]]，参数 θ = [a, b]，每拍更新：
+ *              K = P·φ / (λ + φᵀ·P·φ)，θ += K·(y - φᵀ·θ)，P = (P - K·φᵀ·P) / λ
+ *          2×2 矩阵全部展开为标量运算，每拍只有一次除法。
+ *          激励不足时遗忘因子会让 P 无限增大（协方差爆炸），这里把 P 的迹限制在初值以内。
+ *          由 a、b 可换算出连续模型 K / (τs + 1)，再按极点配置给出 PI 参数：
+ *              对象 K / (τs + 1) 加 PI 后闭环特征方程为 τs² + (1 + K·Kp)s + K·Ki = 0，
+ *              令其等于 τ(s² + 2ζω·s + ω²) 得 Kp = (2ζωτ - 1) / K，Ki = ω²τ / K。
+ *
+ * @note    输入输出最好先归一化到 1 左右，协方差的数值范围更合适。不依赖 HAL。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_rls.h"
+#include <math.h>
+
+// 预测误差指数平均的系数
+#define PID_RLS_ERROR_FILTER 0.05f
+
+void pid_rls_init(PIDRls* rls, float lambda, float p0, float Ts)
+{
+    rls->lambda    = lambda;
+    rls->p0        = p0;
+    rls->Ts        = Ts;
+    rls->a         = 0.0f;
+    rls->b         = 0.0f;
+    rls->P[0][0]   = p0;
+    rls->P[0][1]   = 0.0f;
+    rls->P[1][0]   = 0.0f;
+    rls->P[1][1]   = p0;
+    rls->prev_y    = 0.0f;
+    rls->prev_u    = 0.0f;
+    rls->primed    = 0;
+    rls->error_var = 0.0f;
+    rls->updates   = 0;
+}
+
+void pid_rls_update(PIDRls* rls, float input, float output)
+{
+    if (rls->primed)
+    {
+        float phi0 = rls->prev_y;
+        float phi1 = rls->prev_u;
+        // P·φ
+        float Pphi0 = rls->P[0][0] * phi0 + rls->P[0][1] * phi1;
+        float Pphi1 = rls->P[1][0] * phi0 + rls->P[1][1] * phi1;
+        float denom = rls->lambda + phi0 * Pphi0 + phi1 * Pphi1;
+        float gain0 = Pphi0 / denom;
+        float gain1 = Pphi1 / denom;
+        // 一步预测误差
+        float error = output - (rls->a * phi0 + rls->b * phi1);
+        rls->a += gain0 * error;
+        rls->b += gain1 * error;
+        // P = (P - K·(Pφ)ᵀ) / λ，P 对称，φᵀP = (Pφ)ᵀ
+        float inv_lambda = 1.0f / rls->lambda;
+        float p00        = (rls->P[0][0] - gain0 * Pphi0) * inv_lambda;
+        float p01        = (rls->P[0][1] - gain0 * Pphi1) * inv_lambda;
+        float p11        = (rls->P[1][1] - gain1 * Pphi1) * inv_lambda;
+        // 激励不足时限制协方差的迹，防止遗忘导致的协方差爆炸
+        float trace = p00 + p11;
+        if (trace > 2.0f * rls->p0)
+        {
+            float scale = 2.0f * rls->p0 / trace;
+            p00 *= scale;
+            p01 *= scale;
+            p11 *= scale;
+        }
+        rls->P[0][0] = p00;
+        rls->P[0][1] = p01;
+        rls->P[1][0] = p01;
+        rls->P[1][1] = p11;
+        rls->error_var += PID_RLS_ERROR_FILTER * (error * error - rls->error_var);
+        rls->updates++;
+    }
+    rls->prev_y = output;
+    rls->prev_u = input;
+    rls->primed = 1;
+}
+
+float pid_rls_confidence(const PIDRls* rls)
+{
+    float confidence = 1.0f - (rls->P[0][0] + rls->P[1][1]) / (2.0f * rls->p0);
+    if (confidence < 0.0f)
+        return 0.0f;
+    if (confidence > 1.0f)
+        return 1.0f;
+    return confidence;
+}
+
+uint8_t pid_rls_model(const PIDRls* rls, float* K, float* tau)
+{
+    // 只接受稳定、非振荡的一阶模型
+    if (rls->a <= 0.0f || rls->a >= 1.0f || rls->b == 0.0f)
+    {
+        return 0;
+    }
+    *K   = rls->b / (1.0f - rls->a);
+    *tau = -rls->Ts / logf(rls->a);
+    return 1;
+}
+
+uint8_t pid_rls_pole_placement(const PIDRls* rls, float zeta, float omega, float* Kp, float* Ki)
+{
+    float K, tau;
+    if (!pid_rls_model(rls, &K, &tau) || K <= 0.0f)
+    {
+        return 0;
+    }
+    *Kp = (2.0f * zeta * omega * tau - 1.0f) / K;
+    *Ki = omega * omega * tau / K;
+    // 期望闭环比开环还慢时比例项会变负，此时只保留积分
+    if (*Kp < 0.0f)
+    {
+        *Kp = 0.0f;
+    }
+    return 1;
+}
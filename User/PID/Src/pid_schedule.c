@@ -0,0 +1,90 @@
+/**
+ * @file    pid_schedule.c
+ * @brief   PID 增益调度实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了基于断点表线性插值的 PID 增益调度实现。
+ *          调度变量（如转速）在相邻两拍之间变化很小，因此查找从上次命中的区间开始，
+ *          向左或向右逐个移动，通常 O(1) 完成；区间宽度的倒数只在区间变化时计算一次。
+ *          增益通过 pid_set_gains 写入，积分器会吸收比例项变化，切换无扰动。
+ *
+ * @note    断点表应声明为 const，按调度变量升序排列。不依赖 HAL。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_schedule.h"
+
+/* 重新计算当前区间宽度的倒数 */
+static void pid_schedule_update_span(PIDGainSchedule* schedule)
+{
+    if (schedule->count < 2)
+    {
+        schedule->inv_span = 0.0f;
+        return;
+    }
+    float span = schedule->table[schedule->segment + 1].x - schedule->table[schedule->segment].x;
+    schedule->inv_span = span > 0.0f ? 1.0f / span : 0.0f;
+}
+
+void pid_schedule_init(PIDGainSchedule* schedule, const PIDGainPoint* table, uint8_t count)
+{
+    schedule->table   = table;
+    schedule->count   = count;
+    schedule->segment = 0;
+    pid_schedule_update_span(schedule);
+}
+
+void pid_schedule_lookup(PIDGainSchedule* schedule, float x, float* Kp, float* Ki, float* Kd)
+{
+    const PIDGainPoint* table = schedule->table;
+    uint8_t last              = schedule->count - 1;
+    uint8_t segment           = schedule->segment;
+
+    if (schedule->count < 2 || x <= table[0].x)
+    {
+        *Kp = table[0].Kp;
+        *Ki = table[0].Ki;
+        *Kd = table[0].Kd;
+        return;
+    }
+    if (x >= table[last].x)
+    {
+        *Kp = table[last].Kp;
+        *Ki = table[last].Ki;
+        *Kd = table[last].Kd;
+        return;
+    }
+
+    // 从上次的区间出发增量查找
+    while (segment > 0 && x < table[segment].x)
+    {
+        segment--;
+    }
+    while (segment < last - 1 && x > table[segment + 1].x)
+    {
+        segment++;
+    }
+    if (segment != schedule->segment)
+    {
+        schedule->segment = segment;
+        pid_schedule_update_span(schedule);
+    }
+
+    // 线性插值
+    const PIDGainPoint* lo = &table[segment];
+    const PIDGainPoint* hi = &table[segment + 1];
+    float t                = (x - lo->x) * schedule->inv_span;
+    *Kp                    = lo->Kp + (hi->Kp - lo->Kp) * t;
+    *Ki                    = lo->Ki + (hi->Ki - lo->Ki) * t;
+    *Kd                    = lo->Kd + (hi->Kd - lo->Kd) * t;
+}
+
+void pid_schedule_apply(PIDGainSchedule* schedule, PIDController* pid, float x)
+{
+    float Kp, Ki, Kd;
+    pid_schedule_lookup(schedule, x, &Kp, &Ki, &Kd);
+    pid_set_gains(pid, Kp, Ki, Kd);
+}
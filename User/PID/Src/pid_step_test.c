@@ -0,0 +1,230 @@
+/**
+ * @file    pid_step_test.c
+ * @brief   开环阶跃测试与 FOPDT 模型拟合实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了开环阶跃测试的记录、FOPDT 模型拟合和参数整定。
+ *          记录阶段在定时器中断中运行，每 decimation 拍写一次环形缓冲区；
+ *          缓冲区写满（阶跃前保留 PID_STEP_TEST_PRE_SAMPLES 点基线）后停止记录。
+ *          拟合采用两点法（Smith）：响应到达 28.3% 和 63.2% 的时刻 t1、t2，
+ *              τ = 1.5·(t2 - t1)，θ = t2 - τ，K = Δy / Δu
+ *          稳态值取最后 1/8 采样的平均，基线取阶跃前采样的平均，穿越时刻线性插值；
+ *          最后 1/8 的前后两半平均值相差超过 PID_STEP_TEST_SETTLE_TOLERANCE·Δy 时视为未达到稳态。
+ *          整定规则：
+ *              SIMC PI：Kc = τ / (K·(τc + θ))，Ti = min(τ, 4·(τc + θ))，τc = θ
+ *              IMC PID：Kc = (τ + θ/2) / (K·(λ + θ/2))，Ti = τ + θ/2，Td = τθ / (2τ + θ)
+ *
+ * @note    不依赖 HAL，可在 PC 上用 pid_plant 生成的合成数据验证拟合。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_step_test.h"
+#include <math.h>
+
+void pid_step_test_init(PIDStepTest* test, float u0, float u1, float Ts, uint32_t baseline_ticks,
+                        uint16_t decimation)
+{
+    if (decimation == 0)
+    {
+        decimation = 1;
+    }
+    // 基线节拍数向上取整到记录间隔
+    uint32_t baseline_samples = (baseline_ticks + decimation - 1) / decimation;
+    if (baseline_samples < PID_STEP_TEST_PRE_SAMPLES)
+    {
+        baseline_samples = PID_STEP_TEST_PRE_SAMPLES;
+    }
+    if (baseline_samples > UINT16_MAX)
+    {
+        baseline_samples = UINT16_MAX;
+    }
+    test->u0               = u0;
+    test->u1               = u1;
+    test->Ts               = Ts * decimation;
+    test->decimation       = decimation;
+    test->baseline_samples = (uint16_t)baseline_samples;
+    test->state            = PID_STEP_TEST_BASELINE;
+    test->phase            = 0;
+    test->tick             = 0;
+    test->head             = 0;
+    test->K                = 0.0f;
+    test->tau              = 0.0f;
+    test->theta            = 0.0f;
+}
+
+float pid_step_test_update(PIDStepTest* test, float measurement)
+{
+    if (test->state != PID_STEP_TEST_BASELINE && test->state != PID_STEP_TEST_RECORDING)
+    {
+        return test->u0;
+    }
+    // 两次记录之间保持当前阶段的控制量
+    if (++test->phase < test->decimation)
+    {
+        return test->state == PID_STEP_TEST_BASELINE ? test->u0 : test->u1;
+    }
+    test->phase = 0;
+
+    test->samples[test->head] = measurement;
+    test->head++;
+    if (test->head >= PID_STEP_TEST_SAMPLES)
+    {
+        test->head = 0;
+    }
+    test->tick++;
+
+    if (test->state == PID_STEP_TEST_BASELINE)
+    {
+        if (test->tick < test->baseline_samples)
+        {
+            return test->u0;
+        }
+        // 基线结束，本拍开始施加阶跃，此后每 decimation 拍记录一次响应
+        test->state = PID_STEP_TEST_RECORDING;
+        test->tick  = 0;
+        return test->u1;
+    }
+
+    if (test->tick >= PID_STEP_TEST_SAMPLES - PID_STEP_TEST_PRE_SAMPLES)
+    {
+        test->state = PID_STEP_TEST_DONE;
+        return test->u0;
+    }
+    return test->u1;
+}
+
+/* 按时间顺序取第 i 个采样（0 为最旧），记录完成时 head 正好指向最旧的数据 */
+static float pid_step_test_sample(const PIDStepTest* test, uint16_t i)
+{
+    uint16_t index = test->head + i;
+    if (index >= PID_STEP_TEST_SAMPLES)
+    {
+        index -= PID_STEP_TEST_SAMPLES;
+    }
+    return test->samples[index];
+}
+
+/* 归一化响应首次到达 level 的时刻（从阶跃施加时算起，秒），未到达时返回 -1 */
+static float pid_step_test_crossing(const PIDStepTest* test, float y0, float inv_dy, float level)
+{
+    float prev = 0.0f;
+    for (uint16_t i = PID_STEP_TEST_PRE_SAMPLES; i < PID_STEP_TEST_SAMPLES; i++)
+    {
+        float progress = (pid_step_test_sample(test, i) - y0) * inv_dy;
+        if (progress >= level)
+        {
+            // 在相邻两点之间线性插值
+            float frac = progress > prev ? (level - prev) / (progress - prev) : 1.0f;
+            // 第 PID_STEP_TEST_PRE_SAMPLES 个采样是施加阶跃后第一个记录间隔的测量
+            return (i - PID_STEP_TEST_PRE_SAMPLES + frac) * test->Ts;
+        }
+        prev = progress;
+    }
+    return -1.0f;
+}
+
+uint8_t pid_step_test_fit(PIDStepTest* test)
+{
+    if (test->state != PID_STEP_TEST_DONE && test->state != PID_STEP_TEST_FITTED)
+    {
+        return 0;
+    }
+    test->state = PID_STEP_TEST_FAILED;
+
+    float du = test->u1 - test->u0;
+    if (du == 0.0f)
+    {
+        return 0;
+    }
+
+    // 基线：阶跃前采样的平均；稳态：最后 1/8 采样的平均
+    float y0 = 0.0f;
+    for (uint16_t i = 0; i < PID_STEP_TEST_PRE_SAMPLES; i++)
+    {
+        y0 += pid_step_test_sample(test, i);
+    }
+    y0 /= PID_STEP_TEST_PRE_SAMPLES;
+    // 末尾 1/8 分成前后两段分别求平均，两段之差反映响应是否仍在变化
+    uint16_t tail = PID_STEP_TEST_SAMPLES / 8;
+    uint16_t half = tail / 2;
+    float y_early = 0.0f;
+    float y_late  = 0.0f;
+    for (uint16_t i = PID_STEP_TEST_SAMPLES - tail; i < PID_STEP_TEST_SAMPLES - half; i++)
+    {
+        y_early += pid_step_test_sample(test, i);
+    }
+    for (uint16_t i = PID_STEP_TEST_SAMPLES - half; i < PID_STEP_TEST_SAMPLES; i++)
+    {
+        y_late += pid_step_test_sample(test, i);
+    }
+    float y_end = (y_early + y_late) / tail;
+
+    float dy = y_end - y0;
+    if (fabsf(dy) < 1e-6f)
+    {
+        return 0;
+    }
+    // 未达到稳态：记录时长不够，稳态值和两点法的穿越时刻都会偏
+    if (fabsf(y_late - y_early) / half > PID_STEP_TEST_SETTLE_TOLERANCE * fabsf(dy))
+    {
+        return 0;
+    }
+
+    float t1 = pid_step_test_crossing(test, y0, 1.0f / dy, 0.283f);
+    float t2 = pid_step_test_crossing(test, y0, 1.0f / dy, 0.632f);
+    if (t1 < 0.0f || t2 <= t1)
+    {
+        return 0;
+    }
+
+    test->K     = dy / du;
+    test->tau   = 1.5f * (t2 - t1);
+    test->theta = t2 - test->tau;
+    if (test->theta < 0.0f)
+    {
+        test->theta = 0.0f;
+    }
+    test->state = PID_STEP_TEST_FITTED;
+    return 1;
+}
+
+uint8_t pid_step_test_gains(const PIDStepTest* test, PIDFopdtRule rule, float* Kp, float* Ki,
+                            float* Kd)
+{
+    if (test->state != PID_STEP_TEST_FITTED || test->K == 0.0f)
+    {
+        return 0;
+    }
+
+    float K = test->K, tau = test->tau, theta = test->theta;
+    float Ti, Td;
+    switch (rule)
+    {
+    case PID_FOPDT_IMC:
+    {
+        // λ 不小于纯滞后，也不小于 0.2τ 和一个采样周期
+        float lambda = fmaxf(fmaxf(theta, 0.2f * tau), test->Ts);
+        *Kp          = (tau + 0.5f * theta) / (K * (lambda + 0.5f * theta));
+        Ti           = tau + 0.5f * theta;
+        Td           = tau * theta / (2.0f * tau + theta);
+        break;
+    }
+    case PID_FOPDT_SIMC:
+    default:
+    {
+        // 纯滞后小于一个采样周期时按一个采样周期取 τc，避免增益无穷大
+        float tau_c = fmaxf(theta, test->Ts);
+        *Kp         = tau / (K * (tau_c + theta));
+        Ti          = fminf(tau, 4.0f * (tau_c + theta));
+        Td          = 0.0f;
+        break;
+    }
+    }
+    // pid_update 中积分项为 Ki * ∫e dt，微分项为 Kd * de/dt
+    *Ki = *Kp / Ti;
+    *Kd = *Kp * Td;
+    return 1;
+}
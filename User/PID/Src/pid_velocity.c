@@ -0,0 +1,105 @@
+/**
+ * @file    pid_velocity.c
+ * @brief   增量式（速度型）PID 控制器实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了增量式 PID 控制器的实现。
+ *          每拍只计算控制量增量 Δu，再累加到上一拍实际输出的控制量上：
+ *              Δu = Kp·(e[k] - e[k-1]) + Ki·Ts·e[k] + (D[k] - D[k-1])
+ *          控制器的“积分状态”就是上一拍的控制量本身，因此：
+ *          1. 手动控制时用 pid_velocity_track 记下执行器实际控制量，切回闭环不会跳变；
+ *          2. 输出饱和时直接限幅即可，不需要像位置式那样撤销积分累加量。
+ *
+ * @note    微分项同样使用测量值微分 + 一阶低通滤波。不依赖 HAL。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_velocity.h"
+
+/* 限幅辅助 */
+static float clampf(float v, float lo, float hi)
+{
+    if (v < lo)
+        return lo;
+    if (v > hi)
+        return hi;
+    return v;
+}
+
+/* 按增益、采样周期和滤波时间常数刷新预计算系数 */
+static void pid_velocity_update_coefficients(PIDVelocity* pid)
+{
+    float Ts     = pid->Ts;
+    float tau    = pid->tau;
+    pid->ki_ts   = pid->Ki * Ts;
+    pid->kd_diff = pid->Kd / Ts;
+    if (tau > 0.0f)
+    {
+        pid->alpha     = (2.0f * tau - Ts) / (2.0f * tau + Ts);
+        pid->kd_filter = 2.0f * pid->Kd / ((2.0f * tau + Ts) * Ts);
+    }
+    else
+    {
+        pid->alpha     = 0.0f;
+        pid->kd_filter = 0.0f;
+    }
+}
+
+void pid_velocity_init(PIDVelocity* pid, float Kp, float Ki, float Kd, float Ts, float out_min,
+                       float out_max, float tau)
+{
+    pid->Kp      = Kp;
+    pid->Ki      = Ki;
+    pid->Kd      = Kd;
+    pid->Ts      = Ts;
+    pid->tau     = tau;
+    pid->out_min = out_min;
+    pid->out_max = out_max;
+    pid_velocity_update_coefficients(pid);
+    pid_velocity_track(pid, 0.0f, 0.0f, 0.0f);
+}
+
+void pid_velocity_set_sample_time(PIDVelocity* pid, float Ts, float tau)
+{
+    // 只刷新系数，上一拍的控制量和历史值保留，运行中切换节拍不会让输出回到 0
+    pid->Ts  = Ts;
+    pid->tau = tau;
+    pid_velocity_update_coefficients(pid);
+}
+
+void pid_velocity_track(PIDVelocity* pid, float output, float setpoint, float measurement)
+{
+    pid->output           = clampf(output, pid->out_min, pid->out_max);
+    pid->prev_error       = setpoint - measurement;
+    pid->prev_measurement = measurement;
+    pid->differentiator   = 0.0f;
+}
+
+float pid_velocity_update(PIDVelocity* pid, float setpoint, float measurement)
+{
+    float error = setpoint - measurement;
+    // 微分项（与 pid_update 相同的滤波形式）
+    float D;
+    if (pid->tau <= 0.0f)
+    {
+        D = pid->kd_diff * (error - pid->prev_error);
+    }
+    else
+    {
+        D = pid->alpha * pid->differentiator -
+            pid->kd_filter * (measurement - pid->prev_measurement);
+    }
+    // 增量：比例项差分 + 积分项（矩形）+ 微分项差分
+    float delta = pid->Kp * (error - pid->prev_error) + pid->ki_ts * error +
+                  (D - pid->differentiator);
+    // 累加后直接限幅，饱和时控制量停在边界上，不会积分饱和
+    pid->output = clampf(pid->output + delta, pid->out_min, pid->out_max);
+    // 更新历史值
+    pid->differentiator   = D;
+    pid->prev_error       = error;
+    pid->prev_measurement = measurement;
+    return pid->output;
+}
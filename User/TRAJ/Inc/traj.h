@@ -0,0 +1,65 @@
+#ifndef __TRAJ_H
+#define __TRAJ_H
+
+#include <stdint.h>
+
+// 轨迹类型
+typedef enum
+{
+    TRAJ_MODE_VELOCITY = 0, // 速度轨迹：输出速度设定值，目标为速度
+    TRAJ_MODE_POSITION      // 位置轨迹：输出位置设定值，目标为位置
+} TrajMode;
+
+// 位置轨迹所处的阶段
+typedef enum
+{
+    TRAJ_PHASE_MOVE = 0, // 向最大速度加速或匀速
+    TRAJ_PHASE_BRAKE,    // 按规划的刹车曲线减速，停在目标上
+    TRAJ_PHASE_OVERRUN   // 剩余距离不够刹车，按最大减速刹停后再折返
+} TrajPhase;
+
+// 刹车曲线：以 jerk 把加速度变到 acc_peak，保持 t2，再以 +max_jerk 回到 0（朝目标为正）
+typedef struct
+{
+    float pos;      // 刹车开始时的位置
+    float vel;      // 刹车开始时的速度
+    float acc;      // 刹车开始时的加速度
+    float jerk;     // 第一段的加加速度
+    float acc_peak; // 峰值减速度（<= 0）
+    float t1;       // 第一段时长（秒）
+    float t2;       // 匀减速段时长（秒）
+    float t3;       // 减速度回到 0 的时长（秒）
+} TrajBrake;
+
+// 加加速度（jerk）受限的 S 曲线轨迹发生器
+typedef struct
+{
+    TrajMode mode;
+    float max_vel;  // 最大速度（仅位置轨迹使用）
+    float max_acc;  // 最大加速度
+    float max_jerk; // 最大加加速度
+    float Ts;       // 采样周期（秒）
+    float target;   // 目标值（速度或位置）
+    // 当前轨迹状态
+    float pos;
+    float vel;
+    float acc;
+    // 位置轨迹的刹车规划
+    TrajPhase phase;
+    float dir;        // 刹车方向（+1 或 -1）
+    float brake_time; // 已刹车的时间（秒）
+    TrajBrake brake;
+} Trajectory;
+
+// 初始化轨迹发生器（限幅均取正值）
+void traj_init(Trajectory* traj, TrajMode mode, float max_vel, float max_acc, float max_jerk,
+               float Ts);
+// 从给定的当前位置和速度开始生成轨迹（切换时无扰）
+void traj_reset(Trajectory* traj, float pos, float vel);
+void traj_set_target(Trajectory* traj, float target);
+// 每个采样节拍调用一次，返回本节拍的设定值（速度轨迹返回速度，位置轨迹返回位置）
+float traj_update(Trajectory* traj);
+// 是否已到达目标并静止
+uint8_t traj_done(const Trajectory* traj);
+
+#endif
@@ -0,0 +1,269 @@
+/**
+ * @file    traj.c
+ * @brief   S 曲线轨迹发生器实现文件
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 该文件包含了加加速度（jerk）受限的在线轨迹发生器的实现。
+ *          每个采样节拍把设定值向目标推进一步，加速度以不超过 max_jerk 的斜率变化，
+ *          因此速度呈 S 形过渡，避免目标阶跃使 PWM 饱和、积分器饱和。
+ *          速度轨迹：本拍的加速度取在“此后每拍按 max_jerk 把加速度降到 0 正好到达目标速度”的
+ *          曲线上，再按加加速度和加速度限幅；加速度逐拍降到 0，不会一步跳变。
+ *          位置轨迹：先按速度轨迹向最大速度加速，每拍检查本拍结束时的刹车距离，
+ *          剩余距离即将不够时在拍内求出开始刹车的时刻，规划加加速度受限的刹车曲线
+ *          （-J 降到峰值减速度、匀减速、+J 回到 0），此后按时间在曲线上取样，停在目标上。
+ *          加速度在拍内线性变化，位置按三次多项式积分，与刹车曲线的距离计算一致。
+ *
+ * @note    该模块不依赖 HAL，可在 TIM2 中断中调用，也可在 PC 上验证。
+ *
+ * @copyright Copyright © 2025 HuiSpec. All rights reserved.
+ */
+
+#include "traj.h"
+#include <math.h>
+
+// 求拍内开始刹车时刻的二分次数，误差为 Ts / 2^20
+#define TRAJ_BRAKE_SEARCH_ITERATIONS 20
+
+void traj_init(Trajectory* traj, TrajMode mode, float max_vel, float max_acc, float max_jerk,
+               float Ts)
+{
+    traj->mode     = mode;
+    traj->max_vel  = max_vel;
+    traj->max_acc  = max_acc;
+    traj->max_jerk = max_jerk;
+    traj->Ts       = Ts;
+    traj_reset(traj, 0.0f, 0.0f);
+}
+
+void traj_reset(Trajectory* traj, float pos, float vel)
+{
+    traj->pos    = pos;
+    traj->vel    = vel;
+    traj->acc    = 0.0f;
+    traj->target = traj->mode == TRAJ_MODE_POSITION ? pos : vel;
+    traj->phase  = TRAJ_PHASE_MOVE;
+}
+
+void traj_set_target(Trajectory* traj, float target)
+{
+    // 刹车中目标改变：放弃原刹车曲线，下一拍从当前状态重新决定
+    if (target != traj->target)
+    {
+        traj->phase = TRAJ_PHASE_MOVE;
+    }
+    traj->target = target;
+}
+
+/* 以加加速度受限的方式让 vel 跟踪 v_target，本拍内加速度从 acc 线性变到新的 acc */
+static void traj_track_velocity(Trajectory* traj, float v_target)
+{
+    float Ts        = traj->Ts;
+    float jerk_step = traj->max_jerk * Ts;
+    float acc       = traj->acc;
+    // 本拍把加速度降到 0 之后与目标速度还差多少
+    float remaining = v_target - traj->vel - 0.5f * acc * Ts;
+
+    // 已足够接近：本拍把加速度降到 0 正好落到目标上
+    if (fabsf(acc) <= jerk_step &&
+        fabsf(remaining) <= 0.01f * jerk_step * Ts + 1e-6f * fabsf(v_target))
+    {
+        traj->vel = v_target;
+        traj->acc = 0.0f;
+        return;
+    }
+
+    // 加速度 a 此后每拍减小 jerk_step 降到 0，速度还会变化 f(a)。取满足 a·Ts/2 + f(a) = remaining
+    // 的 a，此后每拍正好减小 jerk_step 就能停在目标上；a ∈ [n, n + 1)·jerk_step 时左边是 a 的
+    // 一次函数 Ts·((n + 1)·a - n(n + 1)/2·jerk_step)，先由 remaining 求出 n 再解出 a
+    float magnitude = fabsf(remaining);
+    float n         = floorf(0.5f * (sqrtf(1.0f + 8.0f * magnitude / (jerk_step * Ts)) - 1.0f));
+    float acc_next  = magnitude / (Ts * (n + 1.0f)) + 0.5f * n * jerk_step;
+    if (remaining < 0.0f)
+    {
+        acc_next = -acc_next;
+    }
+    // 加速度按加加速度限制向曲线靠拢，再按最大加速度限幅
+    acc_next = fminf(fmaxf(acc_next, acc - jerk_step), acc + jerk_step);
+    acc_next = fminf(fmaxf(acc_next, -traj->max_acc), traj->max_acc);
+
+    traj->vel += 0.5f * (acc + acc_next) * Ts;
+    traj->acc = acc_next;
+}
+
+/* 刹车曲线上 t 时刻（从刹车开始算起）相对刹车起点的位移、速度和加速度（朝目标为正） */
+static void traj_brake_sample(const TrajBrake* plan, float J, float t, float* distance,
+                              float* vel, float* acc)
+{
+    // 第一段：以 jerk 把加速度变到 acc_peak
+    float dt = fminf(t, plan->t1);
+    float s  = plan->vel * dt + 0.5f * plan->acc * dt * dt + plan->jerk * dt * dt * dt / 6.0f;
+    float v  = plan->vel + plan->acc * dt + 0.5f * plan->jerk * dt * dt;
+    float a  = plan->acc + plan->jerk * dt;
+    // 第二段：匀减速
+    t -= plan->t1;
+    if (t > 0.0f)
+    {
+        a  = plan->acc_peak;
+        dt = fminf(t, plan->t2);
+        s += v * dt + 0.5f * a * dt * dt;
+        v += a * dt;
+        // 第三段：以 +J 把减速度降回 0
+        t -= plan->t2;
+        if (t > 0.0f)
+        {
+            dt = fminf(t, plan->t3);
+            s += v * dt + 0.5f * a * dt * dt + J * dt * dt * dt / 6.0f;
+            v += a * dt + 0.5f * J * dt * dt;
+            a += J * dt;
+        }
+    }
+    *distance = s;
+    *vel      = v;
+    *acc      = a;
+}
+
+/* 规划从速度 vel、加速度 acc（朝目标为正）以最大加加速度和最大减速度刹停的曲线，返回刹车距离 */
+static float traj_plan_brake(const Trajectory* traj, float vel, float acc, TrajBrake* plan)
+{
+    float J = traj->max_jerk;
+    // 峰值减速度 a_p：先以 -J 降到 a_p，再以 +J 回到 0，速度恰好降到 0
+    float a_peak = -sqrtf(fmaxf(vel * J + 0.5f * acc * acc, 0.0f));
+    if (a_peak < -traj->max_acc)
+    {
+        a_peak = -traj->max_acc;
+    }
+    // 当前减速度已经更大：直接以 +J 回到 0
+    if (a_peak > acc)
+    {
+        a_peak = acc;
+    }
+    float t1 = (acc - a_peak) / J;
+    // 加速度受限时中间以 a_p 匀减速 t2
+    float v1 = vel + (acc * acc - a_peak * a_peak) / (2.0f * J);
+    float t2 = a_peak < 0.0f ? (v1 - a_peak * a_peak / (2.0f * J)) / -a_peak : 0.0f;
+    if (t2 < 0.0f)
+    {
+        t2 = 0.0f;
+    }
+    plan->vel      = vel;
+    plan->acc      = acc;
+    plan->jerk     = -J;
+    plan->acc_peak = a_peak;
+    plan->t1       = t1;
+    plan->t2       = t2;
+    plan->t3       = -a_peak / J;
+
+    float distance, v_end, a_end;
+    traj_brake_sample(plan, J, t1 + t2 + plan->t3, &distance, &v_end, &a_end);
+    return distance;
+}
+
+/* 按 brake_time 在刹车曲线上取样，刹车结束时停下并回到 TRAJ_PHASE_MOVE */
+static float traj_follow_brake(Trajectory* traj)
+{
+    const TrajBrake* plan = &traj->brake;
+    float distance, vel, acc;
+    if (traj->brake_time >= plan->t1 + plan->t2 + plan->t3)
+    {
+        // 规划时剩余距离足够：停在目标上；否则停在刹车曲线终点，下一拍起折返
+        traj_brake_sample(plan, traj->max_jerk, plan->t1 + plan->t2 + plan->t3, &distance, &vel,
+                          &acc);
+        traj->pos   = traj->phase == TRAJ_PHASE_BRAKE ? traj->target
+                                                      : plan->pos + traj->dir * distance;
+        traj->vel   = 0.0f;
+        traj->acc   = 0.0f;
+        traj->phase = TRAJ_PHASE_MOVE;
+        return traj->pos;
+    }
+    traj_brake_sample(plan, traj->max_jerk, traj->brake_time, &distance, &vel, &acc);
+    traj->pos = plan->pos + traj->dir * distance;
+    traj->vel = traj->dir * vel;
+    traj->acc = traj->dir * acc;
+    return traj->pos;
+}
+
+float traj_update(Trajectory* traj)
+{
+    float Ts  = traj->Ts;
+    float pos = traj->pos, vel = traj->vel, acc = traj->acc;
+    if (traj->mode == TRAJ_MODE_VELOCITY)
+    {
+        traj_track_velocity(traj, traj->target);
+        traj->pos = pos + vel * Ts + (2.0f * acc + traj->acc) * Ts * Ts / 6.0f;
+        return traj->vel;
+    }
+
+    if (traj->phase != TRAJ_PHASE_MOVE)
+    {
+        traj->brake_time += Ts;
+        return traj_follow_brake(traj);
+    }
+    float dp = traj->target - pos;
+    if (dp == 0.0f && vel == 0.0f && acc == 0.0f)
+    {
+        return pos;
+    }
+
+    // 统一到“朝目标为正”的方向上：先按向最大速度加速走一拍，本拍内加加速度恒定
+    float dir      = dp >= 0.0f ? 1.0f : -1.0f;
+    float distance = dir * dp;
+    float v0       = dir * vel, a0 = dir * acc;
+    traj_track_velocity(traj, dir * traj->max_vel);
+    float a1   = dir * traj->acc;
+    float jerk = (a1 - a0) / Ts;
+    float s1   = v0 * Ts + (2.0f * a0 + a1) * Ts * Ts / 6.0f;
+    TrajBrake plan;
+    if (traj_plan_brake(traj, dir * traj->vel, a1, &plan) < distance - s1)
+    {
+        // 本拍结束时仍来得及刹车
+        traj->pos = pos + dir * s1;
+        return traj->pos;
+    }
+
+    // 在本拍内二分求出剩余距离正好等于刹车距离的时刻 τ，从 τ 开始刹车；
+    // 拍首已经来不及时从拍首按最大减速刹车，停下后再折返
+    float tau = 0.0f, s = 0.0f, v = v0, a = a0;
+    if (traj_plan_brake(traj, v0, a0, &plan) > distance * (1.0f + 1e-4f))
+    {
+        traj->phase = TRAJ_PHASE_OVERRUN;
+    }
+    else
+    {
+        traj->phase = TRAJ_PHASE_BRAKE;
+        float hi    = Ts;
+        for (uint8_t i = 0; i < TRAJ_BRAKE_SEARCH_ITERATIONS; i++)
+        {
+            float mid   = 0.5f * (tau + hi);
+            float s_mid = v0 * mid + 0.5f * a0 * mid * mid + jerk * mid * mid * mid / 6.0f;
+            float v_mid = v0 + a0 * mid + 0.5f * jerk * mid * mid;
+            float a_mid = a0 + jerk * mid;
+            if (traj_plan_brake(traj, v_mid, a_mid, &plan) < distance - s_mid)
+            {
+                tau = mid;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        s = v0 * tau + 0.5f * a0 * tau * tau + jerk * tau * tau * tau / 6.0f;
+        v = v0 + a0 * tau + 0.5f * jerk * tau * tau;
+        a = a0 + jerk * tau;
+    }
+    traj_plan_brake(traj, v, a, &traj->brake);
+    traj->brake.pos  = pos + dir * s;
+    traj->dir        = dir;
+    traj->brake_time = Ts - tau;
+    return traj_follow_brake(traj);
+}
+
+uint8_t traj_done(const Trajectory* traj)
+{
+    if (traj->mode == TRAJ_MODE_VELOCITY)
+    {
+        return traj->vel == traj->target && traj->acc == 0.0f;
+    }
+    return traj->pos == traj->target && traj->vel == 0.0f;
+}
@@ -0,0 +1,340 @@
+/**
+ * @file    bench_pid.c
+ * @brief   PID 控制器单次更新耗时基准测试
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 对 pid_update、pid_update_ff_dt（实测周期偏离标称值；二自由度 + 前馈）、
+ *          pid_velocity_update、pid_schedule_apply + pid_update、pid_cascade_update、
+ *          pid_q_update、pid_bank_update 和编码器测速管线 encoder_speed_measure
+ *          各循环 BENCH_ITERATIONS 次，
+ *          打印每次更新的平均耗时（ns）和处理器周期数（x86 为 TSC，aarch64 为虚拟计数器，
+ *          频率与核心时钟不一定相同）。测速管线另有一份按 64 位除法折算实测周期的副本
+ *          （改动前的写法）作为对照：一次用本机的除法指令，一次用与 M3 上 __aeabi_ldivmod
+ *          相同的移位相减算法，并打印新旧两种折算得到的速度的最大偏差。
+ *          输入取自一段预先生成的测量序列，避免编译器把循环常量折叠。
+ *
+ * @note    PC 有硬件浮点和 64 位除法指令，这里的数字只用于同一台机器上比较改动前后的相对变化，
+ *          不代表 Cortex-M3 上软浮点与定点的比例；M3 上 64 位除法是库函数 __aeabi_ldivmod，
+ *          省下的周期比这里更多。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid.h"
+#include "pid_bank.h"
+#include "pid_cascade.h"
+#include "pid_q.h"
+#include "pid_schedule.h"
+#include "pid_velocity.h"
+#include "encoder_speed.h"
+#include "test_common.h"
+#include <math.h>
+
+#define BENCH_ITERATIONS 2000000
+#define BENCH_INPUTS 1024 // 测量序列长度（2 的幂）
+
+#define BENCH_CLOCK_HZ 72000000 // 测速管线的周期计数器频率（与 STM32F103 主频相同）
+#define BENCH_SPEED_FS 1000.0f  // 测速管线的控制频率
+
+static float inputs[BENCH_INPUTS];
+static q16_t inputs_q[BENCH_INPUTS];
+static int32_t speed_counts[BENCH_INPUTS]; // 每拍计数差
+static uint32_t speed_dt[BENCH_INPUTS];    // 每拍实测周期，标称值 ±1% 抖动
+static volatile float sink;
+static volatile q16_t sink_q;
+
+/* 打印一行结果：每次更新的纳秒数和周期数 */
+static void bench_report(const char* name, uint64_t ns, uint64_t cycles, uint32_t updates)
+{
+    printf("%-32s %8.2f ns/update %8.2f cycles/update\n", name, (double)ns / updates,
+           (double)cycles / updates);
+}
+
+static void bench_pid_float(void)
+{
+    PIDController pid;
+    pid_init(&pid, 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    uint64_t c0    = test_cycles();
+    for (uint32_t k = 0; k < BENCH_ITERATIONS; k++)
+    {
+        acc += pid_update(&pid, 1.0f, inputs[k & (BENCH_INPUTS - 1)]);
+    }
+    uint64_t cycles = test_cycles() - c0;
+    uint64_t ns     = test_now_ns() - start;
+    sink            = acc;
+    bench_report("pid_update", ns, cycles, BENCH_ITERATIONS);
+}
+
+static void bench_pid_float_dt(void)
+{
+    PIDController pid;
+    pid_init(&pid, 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    uint64_t c0    = test_cycles();
+    for (uint32_t k = 0; k < BENCH_ITERATIONS; k++)
+    {
+        // 实测周期在标称值 ±2% 之间交替，每拍都走缩放路径
+        float dt = (k & 1) ? 0.00102f : 0.00098f;
+        acc += pid_update_ff_dt(&pid, 1.0f, inputs[k & (BENCH_INPUTS - 1)], 0.0f, dt);
+    }
+    uint64_t cycles = test_cycles() - c0;
+    uint64_t ns     = test_now_ns() - start;
+    sink            = acc;
+    bench_report("pid_update_ff_dt (off-nominal)", ns, cycles, BENCH_ITERATIONS);
+}
+
+static void bench_pid_2dof_ff(void)
+{
+    PIDController pid;
+    pid_init(&pid, 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+    pid_set_setpoint_weights(&pid, 0.5f, 0.0f);
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    uint64_t c0    = test_cycles();
+    for (uint32_t k = 0; k < BENCH_ITERATIONS; k++)
+    {
+        // 标称周期，走 pid_update_ff 路径；前馈随设定值变化
+        acc += pid_update_ff_dt(&pid, 1.0f, inputs[k & (BENCH_INPUTS - 1)], 0.4f, 0.001f);
+    }
+    uint64_t cycles = test_cycles() - c0;
+    uint64_t ns     = test_now_ns() - start;
+    sink            = acc;
+    bench_report("pid_update_ff_dt (2dof+ff)", ns, cycles, BENCH_ITERATIONS);
+}
+
+static void bench_pid_velocity(void)
+{
+    PIDVelocity pid;
+    pid_velocity_init(&pid, 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    uint64_t c0    = test_cycles();
+    for (uint32_t k = 0; k < BENCH_ITERATIONS; k++)
+    {
+        acc += pid_velocity_update(&pid, 1.0f, inputs[k & (BENCH_INPUTS - 1)]);
+    }
+    uint64_t cycles = test_cycles() - c0;
+    uint64_t ns     = test_now_ns() - start;
+    sink            = acc;
+    bench_report("pid_velocity_update", ns, cycles, BENCH_ITERATIONS);
+}
+
+static void bench_pid_schedule(void)
+{
+    static const PIDGainPoint table[] = {
+        {0.9f, 3.0f, 7.5f, 0.012f},
+        {1.0f, 2.5f, 6.25f, 0.01f},
+        {1.1f, 2.0f, 5.0f, 0.008f},
+    };
+    PIDGainSchedule schedule;
+    PIDController pid;
+    pid_schedule_init(&schedule, table, sizeof(table) / sizeof(table[0]));
+    pid_init(&pid, 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    uint64_t c0    = test_cycles();
+    for (uint32_t k = 0; k < BENCH_ITERATIONS; k++)
+    {
+        // 以测量值为调度变量，每拍查表并无扰写入增益，常在两个区间之间切换
+        float measurement = inputs[k & (BENCH_INPUTS - 1)];
+        pid_schedule_apply(&schedule, &pid, measurement);
+        acc += pid_update(&pid, 1.0f, measurement);
+    }
+    uint64_t cycles = test_cycles() - c0;
+    uint64_t ns     = test_now_ns() - start;
+    sink            = acc;
+    bench_report("pid_schedule_apply + pid_update", ns, cycles, BENCH_ITERATIONS);
+}
+
+static void bench_pid_cascade(void)
+{
+    PIDController outer, inner;
+    PIDCascade cascade;
+    pid_init(&outer, 1.0f, 0.0f, 0.0f, 0.002f, -100.0f, 100.0f, 0.0f);
+    pid_init(&inner, 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+    // 与 encoder.h 相同：外环 2 分频，内环每拍运行
+    pid_cascade_init(&cascade, &outer, &inner, 2, 1);
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    uint64_t c0    = test_cycles();
+    for (uint32_t k = 0; k < BENCH_ITERATIONS; k++)
+    {
+        float measurement = inputs[k & (BENCH_INPUTS - 1)];
+        acc += pid_cascade_update(&cascade, 1.0f, measurement, measurement - 1.0f);
+    }
+    uint64_t cycles = test_cycles() - c0;
+    uint64_t ns     = test_now_ns() - start;
+    sink            = acc;
+    bench_report("pid_cascade_update (/base tick)", ns, cycles, BENCH_ITERATIONS);
+}
+
+static void bench_pid_fixed(void)
+{
+    PIDControllerQ pid;
+    pid_q_init(&pid, 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+    q16_t acc      = 0;
+    uint64_t start = test_now_ns();
+    uint64_t c0    = test_cycles();
+    for (uint32_t k = 0; k < BENCH_ITERATIONS; k++)
+    {
+        acc += pid_q_update(&pid, Q16_ONE, inputs_q[k & (BENCH_INPUTS - 1)]);
+    }
+    uint64_t cycles = test_cycles() - c0;
+    uint64_t ns     = test_now_ns() - start;
+    sink_q          = acc;
+    bench_report("pid_q_update", ns, cycles, BENCH_ITERATIONS);
+}
+
+static void bench_bank(void)
+{
+    enum
+    {
+        LOOPS = 4
+    };
+    PIDBank bank;
+    float setpoints[LOOPS], measurements[LOOPS], outputs[LOOPS];
+    pid_bank_init(&bank);
+    for (int i = 0; i < LOOPS; i++)
+    {
+        pid_bank_add(&bank, 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+        setpoints[i] = 1.0f;
+    }
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    uint64_t c0    = test_cycles();
+    for (uint32_t k = 0; k < BENCH_ITERATIONS / LOOPS; k++)
+    {
+        for (int i = 0; i < LOOPS; i++)
+        {
+            measurements[i] = inputs[(k + i) & (BENCH_INPUTS - 1)];
+        }
+        pid_bank_update(&bank, setpoints, measurements, outputs);
+        acc += outputs[0];
+    }
+    uint64_t cycles = test_cycles() - c0;
+    uint64_t ns     = test_now_ns() - start;
+    sink            = acc;
+    bench_report("pid_bank_update (4 loops, /loop)", ns, cycles, BENCH_ITERATIONS);
+}
+
+/* 没有 64 位除法指令的内核（Cortex-M3）上 __aeabi_ldivmod 的做法：按位移位相减，
+ * 循环次数为被除数与除数的有效位数之差 */
+__attribute__((noinline)) static int64_t soft_ldiv(int64_t numerator, uint32_t denominator)
+{
+    uint64_t n = numerator < 0 ? -(uint64_t)numerator : (uint64_t)numerator;
+    uint64_t q = 0;
+    if (n >= denominator)
+    {
+        int shift  = __builtin_clz(denominator) + 32 - __builtin_clzll(n);
+        uint64_t d = (uint64_t)denominator << shift;
+        for (; shift >= 0; shift--, d >>= 1)
+        {
+            q <<= 1;
+            if (n >= d)
+            {
+                n -= d;
+                q |= 1;
+            }
+        }
+    }
+    return numerator < 0 ? -(int64_t)q : (int64_t)q;
+}
+
+/* 改动前的测速管线：每拍用 64 位除法按实测周期折算，soft 为 1 时用 soft_ldiv 代替本机的除法指令 */
+__attribute__((noinline)) static float encoder_speed_measure_div(EncoderSpeed* meter,
+                                                                 int32_t counts,
+                                                                 uint32_t dt_cycles, int soft)
+{
+    int64_t counts_q16 = (int64_t)counts << SPEED_FIXED_Q;
+    if (dt_cycles > 0)
+    {
+        counts_q16 = soft ? soft_ldiv(counts_q16 * meter->nominal_cycles, dt_cycles)
+                          : counts_q16 * meter->nominal_cycles / dt_cycles;
+    }
+    int32_t filtered = (int32_t)counts_q16;
+    meter->counts +=
+        (int32_t)((((int64_t)filtered - meter->counts) * SPEED_EMA_Q16) >> SPEED_FIXED_Q);
+    meter->speed = meter->counts * meter->scale;
+    return meter->speed;
+}
+
+static void bench_encoder_speed(void)
+{
+    EncoderSpeed meter, reference;
+    encoder_speed_init(&meter, 60.0f / 176.0f);
+    encoder_speed_init(&reference, 60.0f / 176.0f);
+    encoder_speed_set_rate(&meter, BENCH_SPEED_FS, BENCH_CLOCK_HZ);
+    encoder_speed_set_rate(&reference, BENCH_SPEED_FS, BENCH_CLOCK_HZ);
+
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    uint64_t c0    = test_cycles();
+    for (uint32_t k = 0; k < BENCH_ITERATIONS; k++)
+    {
+        uint32_t i = k & (BENCH_INPUTS - 1);
+        acc += encoder_speed_measure(&meter, speed_counts[i], speed_dt[i]);
+    }
+    uint64_t cycles = test_cycles() - c0;
+    uint64_t ns     = test_now_ns() - start;
+    sink            = acc;
+    bench_report("encoder_speed_measure (jitter)", ns, cycles, BENCH_ITERATIONS);
+
+    static const char* const names[] = {"64-bit divide (before)", "soft 64-bit divide (M3)"};
+    for (int soft = 0; soft <= 1; soft++)
+    {
+        acc   = 0.0f;
+        start = test_now_ns();
+        c0    = test_cycles();
+        for (uint32_t k = 0; k < BENCH_ITERATIONS; k++)
+        {
+            uint32_t i = k & (BENCH_INPUTS - 1);
+            acc += encoder_speed_measure_div(&reference, speed_counts[i], speed_dt[i], soft);
+        }
+        cycles = test_cycles() - c0;
+        ns     = test_now_ns() - start;
+        sink   = acc;
+        bench_report(names[soft], ns, cycles, BENCH_ITERATIONS);
+    }
+
+    // 同一段输入上两种折算得到的速度之差，以满量程（±60 计数/拍）的比例表示
+    double deviation = 0.0;
+    encoder_speed_set_rate(&meter, BENCH_SPEED_FS, BENCH_CLOCK_HZ);
+    encoder_speed_set_rate(&reference, BENCH_SPEED_FS, BENCH_CLOCK_HZ);
+    for (uint32_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        float speed = encoder_speed_measure(&meter, speed_counts[i], speed_dt[i]);
+        float truth = encoder_speed_measure_div(&reference, speed_counts[i], speed_dt[i], 0);
+        deviation   = fmax(deviation, fabs(speed - truth) / (60.0 * reference.scale * 65536.0));
+    }
+    printf("%-32s %8.2g of full scale\n", "max deviation from divide", deviation);
+}
+
+int main(void)
+{
+    // 围绕设定值的小幅波动，控制器不会长期饱和
+    uint32_t seed = 12345;
+    for (int i = 0; i < BENCH_INPUTS; i++)
+    {
+        seed        = seed * 1664525u + 1013904223u;
+        inputs[i]   = 1.0f + ((int32_t)(seed >> 16) - 32768) / 327680.0f;
+        inputs_q[i] = Q16_FROM_FLOAT(inputs[i]);
+        // 约 ±60 计数/拍的计数差，实测周期在标称值 72000 上下 ±1% 抖动
+        speed_counts[i] = (int32_t)(seed >> 25) - 64;
+        speed_dt[i]     = 72000 + (int32_t)((seed >> 8) % 1441) - 720;
+    }
+    bench_pid_float();
+    bench_pid_float_dt();
+    bench_pid_2dof_ff();
+    bench_pid_velocity();
+    bench_pid_schedule();
+    bench_pid_cascade();
+    bench_pid_fixed();
+    bench_bank();
+    bench_encoder_speed();
+    return 0;
+}
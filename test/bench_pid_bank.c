@@ -0,0 +1,103 @@
+/**
+ * @file    bench_pid_bank.c
+ * @brief   控制器组与逐个 pid_update 的耗时对比
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 回路数 N = 1 .. PID_BANK_MAX_LOOPS，每个 N 分别测量：
+ *          1. 一次 pid_bank_update 更新 N 个回路；
+ *          2. N 个独立的 PIDController 依次调用 pid_update。
+ *          两者参数相同、总更新次数相同，打印每个回路每次更新的耗时（ns）和两者之比。
+ *
+ * @note    PC 有硬件浮点和向量单元，这里的比例只说明布局和调用开销的趋势，
+ *          不代表 Cortex-M3 上的绝对收益。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid.h"
+#include "pid_bank.h"
+#include "test_common.h"
+
+#define BENCH_LOOP_UPDATES 4000000 // 每个 N 的回路更新总次数
+#define BENCH_INPUTS 1024          // 测量序列长度（2 的幂）
+
+static float inputs[BENCH_INPUTS];
+static volatile float sink;
+
+/* N 个回路用同一个控制器组更新，返回每个回路每次更新的纳秒数 */
+static double bench_bank(int loops)
+{
+    PIDBank bank;
+    float setpoints[PID_BANK_MAX_LOOPS], measurements[PID_BANK_MAX_LOOPS];
+    float outputs[PID_BANK_MAX_LOOPS];
+    pid_bank_init(&bank);
+    for (int i = 0; i < loops; i++)
+    {
+        pid_bank_add(&bank, 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+        setpoints[i] = 1.0f;
+    }
+    uint32_t ticks = BENCH_LOOP_UPDATES / loops;
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    for (uint32_t k = 0; k < ticks; k++)
+    {
+        for (int i = 0; i < loops; i++)
+        {
+            measurements[i] = inputs[(k + i) & (BENCH_INPUTS - 1)];
+        }
+        pid_bank_update(&bank, setpoints, measurements, outputs);
+        acc += outputs[0];
+    }
+    uint64_t ns = test_now_ns() - start;
+    sink        = acc;
+    return (double)ns / ((double)ticks * loops);
+}
+
+/* N 个独立控制器逐个调用 pid_update，返回每个回路每次更新的纳秒数 */
+static double bench_scalar(int loops)
+{
+    PIDController pid[PID_BANK_MAX_LOOPS];
+    float measurements[PID_BANK_MAX_LOOPS];
+    for (int i = 0; i < loops; i++)
+    {
+        pid_init(&pid[i], 2.5f, 6.25f, 0.01f, 0.001f, -100.0f, 100.0f, 0.005f);
+    }
+    uint32_t ticks = BENCH_LOOP_UPDATES / loops;
+    float acc      = 0.0f;
+    uint64_t start = test_now_ns();
+    for (uint32_t k = 0; k < ticks; k++)
+    {
+        for (int i = 0; i < loops; i++)
+        {
+            measurements[i] = inputs[(k + i) & (BENCH_INPUTS - 1)];
+        }
+        for (int i = 0; i < loops; i++)
+        {
+            acc += pid_update(&pid[i], 1.0f, measurements[i]);
+        }
+    }
+    uint64_t ns = test_now_ns() - start;
+    sink        = acc;
+    return (double)ns / ((double)ticks * loops);
+}
+
+int main(void)
+{
+    // 与 bench_pid 相同的测量序列：围绕设定值的小幅波动
+    uint32_t seed = 12345;
+    for (int i = 0; i < BENCH_INPUTS; i++)
+    {
+        seed      = seed * 1664525u + 1013904223u;
+        inputs[i] = 1.0f + ((int32_t)(seed >> 16) - 32768) / 327680.0f;
+    }
+    printf("%6s %16s %16s %8s\n", "loops", "bank ns/loop", "scalar ns/loop", "ratio");
+    for (int loops = 1; loops <= PID_BANK_MAX_LOOPS; loops++)
+    {
+        double bank   = bench_bank(loops);
+        double scalar = bench_scalar(loops);
+        printf("%6d %16.2f %16.2f %8.2f\n", loops, bank, scalar, scalar / bank);
+    }
+    return 0;
+}
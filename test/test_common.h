@@ -0,0 +1,79 @@
+/**
+ * @file    test_common.h
+ * @brief   主机端测试和基准测试的公共辅助函数
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 每个测试程序单独编译链接，本文件只包含 static 函数：
+ *          test_check / test_range 打印每一项检查的结果并累计失败数，
+ *          test_summary 返回进程退出码；test_now_ns / test_cycles 用于基准测试计时。
+ *
+ * @note    只在 PC 上使用（本机 gcc），不参与固件编译。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static int test_failures = 0;
+static int test_checks   = 0;
+
+/* 检查条件是否成立 */
+static inline void test_check(const char* name, int ok)
+{
+    test_checks++;
+    if (!ok)
+    {
+        test_failures++;
+    }
+    printf("%s %s\n", ok ? "PASS" : "FAIL", name);
+}
+
+/* 检查数值是否落在 [lo, hi] 内，并打印实测值，便于回归时调整阈值 */
+static inline void test_range(const char* name, double value, double lo, double hi)
+{
+    int ok = value >= lo && value <= hi;
+    test_checks++;
+    if (!ok)
+    {
+        test_failures++;
+    }
+    printf("%s %-40s %12.6g  [%g, %g]\n", ok ? "PASS" : "FAIL", name, value, lo, hi);
+}
+
+/* 打印汇总，返回进程退出码 */
+static inline int test_summary(const char* suite)
+{
+    printf("%s: %d checks, %d failed\n", suite, test_checks, test_failures);
+    return test_failures == 0 ? 0 : 1;
+}
+
+/* 单调时钟（纳秒） */
+static inline uint64_t test_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* 处理器周期计数器，没有可用的计数器时返回 0 */
+static inline uint64_t test_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return 0;
+#endif
+}
+
+#endif
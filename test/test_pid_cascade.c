@@ -0,0 +1,176 @@
+/**
+ * @file    test_pid_cascade.c
+ * @brief   串级位置环在直流电机仿真对象上的点到点运动测试
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 带减速器的直流电机（带负载惯量，机械时间常数约 0.5 s）+ 编码器量化
+ *          （减速比和计数取自 encoder_speed.h），基础节拍 100 Hz，
+ *          外环（度 -> 转/分）和内环 PI（转/分 -> 电压）按不同分频经 pid_cascade_update
+ *          驱动电机转 20 圈（7200°），加速段电压顶在 ±12 V。每种分频检查：
+ *          1. 外环为 P（与固件默认相同）：在限定时间内进入 ±1% 误差带，超调量有界，
+ *             最终误差不超过 2 个计数；
+ *          2. 外环为 PI：内环饱和期间外环积分器从不朝饱和方向增长（内环饱和反馈到外环），
+ *             超调量有界，且明显小于不做这一反馈的同参数串级。
+ *          外环输出范围大于电机空载转速，外环本身不饱和而内环饱和，
+ *          外环自身的抗饱和不起作用，第 2 项检查的正是串级的抗积分饱和。
+ *
+ * @note    在 test 目录下运行 make test。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "encoder_speed.h"
+#include "pid.h"
+#include "pid_cascade.h"
+#include "pid_metrics.h"
+#include "pid_plant.h"
+#include "test_common.h"
+#include <math.h>
+
+#define BASE_TS 0.01f
+#define GEAR ((float)REDUCTION_RATIO)
+#define COUNTS_PER_REV (PULSES_PER_REVOLUTION * FREQUENCY_DOUBLING_COEFFICIENT) // 电机轴
+#define VOLTAGE 12.0f
+#define TARGET 7200.0f       // 度
+#define OUTER_LIMIT 12000.0f // 转/分，高于空载转速约 5800 转/分
+#define OUTER_KP 1.0f        // 转/分 / 度，位置环带宽 6 rad/s
+#define OUTER_KI 0.2f        // 只在抗饱和检查中使用，Ti = 5 s
+#define INNER_KP 0.02f       // 伏 / (转/分)，速度环带宽约 20 rad/s
+#define INNER_KI 0.04f       // Ti 取机械时间常数
+#define RUN_TICKS 1000       // 10 秒
+
+/* 一次点到点运动的结果 */
+typedef struct
+{
+    PIDMetrics metrics;
+    float final_error;        // 结束时的位置误差（度）
+    uint32_t saturated_outer; // 内环饱和时运行外环的次数
+    uint32_t windup_ticks;    // 其中外环积分器朝饱和方向增长的次数
+} CascadeRun;
+
+/* 运行一次点到点运动，外环积分增益为 outer_ki，
+ * feedback 为 0 时用同参数的两个 PID 直接串联（不把内环饱和反馈到外环） */
+static void run_cascade(CascadeRun* run, uint8_t outer_divider, uint8_t inner_divider,
+                        float outer_ki, uint8_t feedback)
+{
+    PIDPlantDCMotor motor;
+    PIDPlantEncoder encoder;
+    PIDController outer, inner;
+    PIDCascade cascade;
+    // 折算到电机轴的惯量 5e-6 kg·m²：机械时间常数约 0.5 s，空载约 5800 rpm / 12 V（输出轴）
+    pid_plant_dc_motor_init(&motor, 2.0f, 0.5e-3f, 0.0045f, 0.0045f, 5e-6f, 1e-7f, GEAR, BASE_TS,
+                            20);
+    pid_plant_encoder_init(&encoder, COUNTS_PER_REV, 0.0f);
+    pid_init(&outer, OUTER_KP, outer_ki, 0.0f, BASE_TS * outer_divider, -OUTER_LIMIT,
+             OUTER_LIMIT, 0.0f);
+    pid_init(&inner, INNER_KP, INNER_KI, 0.0f, BASE_TS * inner_divider, -VOLTAGE, VOLTAGE, 0.0f);
+    pid_cascade_init(&cascade, &outer, &inner, outer_divider, inner_divider);
+    pid_metrics_init(&run->metrics, 0.0f, TARGET, 0.01f, BASE_TS);
+    run->saturated_outer = 0;
+    run->windup_ticks    = 0;
+
+    float speed = 0.0f, angle = 0.0f, output = 0.0f, speed_setpoint = 0.0f;
+    int32_t position = 0;
+    for (uint32_t k = 0; k < RUN_TICKS; k++)
+    {
+        uint8_t outer_tick = k % outer_divider == 0;
+        // 上一次内环输出饱和的方向，外环积分不得朝这个方向增长
+        float saturation   = output >= VOLTAGE ? 1.0f : (output <= -VOLTAGE ? -1.0f : 0.0f);
+        float integrator   = outer.integrator;
+        if (feedback)
+        {
+            output = pid_cascade_update(&cascade, TARGET, angle, speed);
+        }
+        else
+        {
+            if (outer_tick)
+            {
+                speed_setpoint = pid_update(&outer, TARGET, angle);
+            }
+            if (k % inner_divider == 0)
+            {
+                output = pid_update(&inner, speed_setpoint, speed);
+            }
+        }
+        if (outer_tick && saturation != 0.0f)
+        {
+            run->saturated_outer++;
+            run->windup_ticks += saturation * (outer.integrator - integrator) > 0.0f;
+        }
+        pid_plant_dc_motor_step(&motor, output, 0.0f);
+        int32_t counts = pid_plant_encoder_read(&encoder, motor.angle);
+        position += counts;
+        speed = counts / COUNTS_PER_REV / BASE_TS * 60.0f / GEAR;
+        angle = COUNTS_TO_DEGREES((float)position);
+        pid_metrics_update(&run->metrics, angle, saturation != 0.0f);
+    }
+    run->final_error = TARGET - angle;
+}
+
+/* 外环为 P：点到点运动完成，超调有界 */
+static void check_move(uint8_t outer_divider, uint8_t inner_divider, float overshoot_max,
+                       float settling_max)
+{
+    CascadeRun run;
+    char label[80];
+    run_cascade(&run, outer_divider, inner_divider, 0.0f, 1);
+    snprintf(label, sizeof(label), "P  outer /%u inner /%u overshoot (%%)", outer_divider,
+             inner_divider);
+    test_range(label, pid_metrics_overshoot(&run.metrics), 0.0, overshoot_max);
+    snprintf(label, sizeof(label), "P  outer /%u inner /%u settling time (s)", outer_divider,
+             inner_divider);
+    test_range(label, pid_metrics_settling_time(&run.metrics), 0.0, settling_max);
+    snprintf(label, sizeof(label), "P  outer /%u inner /%u final error (counts)", outer_divider,
+             inner_divider);
+    test_range(label, fabsf(run.final_error) * COUNTS_PER_OUTPUT_REVOLUTION / 360.0f, 0.0, 2.0);
+}
+
+/* 外环为 PI：内环饱和时外环不积分饱和，超调量明显小于不反馈的串级 */
+static void check_anti_windup(uint8_t outer_divider, uint8_t inner_divider, float overshoot_max,
+                              float settling_max)
+{
+    CascadeRun run, windup;
+    char label[80];
+    run_cascade(&run, outer_divider, inner_divider, OUTER_KI, 1);
+    run_cascade(&windup, outer_divider, inner_divider, OUTER_KI, 0);
+
+    // 内环确实饱和了多个外环周期，外环积分器在这期间一次也没有朝饱和方向增长
+    snprintf(label, sizeof(label), "PI outer /%u inner /%u outer ticks with inner saturated",
+             outer_divider, inner_divider);
+    test_range(label, run.saturated_outer, 3.0, RUN_TICKS);
+    snprintf(label, sizeof(label), "PI outer /%u inner /%u outer integrator winds up",
+             outer_divider, inner_divider);
+    test_range(label, run.windup_ticks, 0.0, 0.0);
+    snprintf(label, sizeof(label), "PI outer /%u inner /%u overshoot (%%)", outer_divider,
+             inner_divider);
+    test_range(label, pid_metrics_overshoot(&run.metrics), 0.0, overshoot_max);
+    snprintf(label, sizeof(label), "PI outer /%u inner /%u settling time (s)", outer_divider,
+             inner_divider);
+    test_range(label, pid_metrics_settling_time(&run.metrics), 0.0, settling_max);
+    // 不反馈时外环积分在饱和期间累积，超调量明显更大
+    snprintf(label, sizeof(label), "PI outer /%u inner /%u winds up without feedback",
+             outer_divider, inner_divider);
+    test_range(label, windup.windup_ticks, 3.0, RUN_TICKS);
+    snprintf(label, sizeof(label), "PI outer /%u inner /%u overshoot without feedback (%%)",
+             outer_divider, inner_divider);
+    test_range(label, pid_metrics_overshoot(&windup.metrics), 2.0 * overshoot_max, 100.0);
+    snprintf(label, sizeof(label), "PI outer /%u inner /%u feedback halves overshoot",
+             outer_divider, inner_divider);
+    test_check(label, pid_metrics_overshoot(&run.metrics) <
+                          0.5f * pid_metrics_overshoot(&windup.metrics));
+}
+
+int main(void)
+{
+    // 外环 2 分频、内环每拍运行与 encoder.h 默认值相同
+    static const uint8_t outer_dividers[] = {2, 5, 4};
+    static const uint8_t inner_dividers[] = {1, 1, 2};
+    for (unsigned i = 0; i < sizeof(outer_dividers) / sizeof(outer_dividers[0]); i++)
+    {
+        check_move(outer_dividers[i], inner_dividers[i], 2.0f, 2.0f);
+        check_anti_windup(outer_dividers[i], inner_dividers[i], 2.0f, 5.0f);
+    }
+    return test_summary("test_pid_cascade");
+}
@@ -0,0 +1,105 @@
+/**
+ * @file    test_pid_q.c
+ * @brief   定点 PID 与浮点 PID 的等价性测试
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 同一组参数分别初始化 pid 和 pid_q，输入相同的 Q16.16 量化序列，
+ *          逐拍比较两者的控制量（相对误差 |u - u_q| / (1 + |u|)）：
+ *          1. 采样周期 10 ms / 1 ms / 0.1 ms，Ki ≈ 1：0.5·Ki·Ts 只有几个 Q16 LSB 时积分不能失真；
+ *          2. 不滤波和带滤波的微分，Kd / Ts 远超 Q16.16 的整数范围；
+ *          3. 恒定误差下积分器的累加量与浮点版本的相对误差；
+ *          4. 微分乘积超出 Q16.16 时饱和到正确的符号，而不是回绕。
+ *
+ * @note    在 test 目录下运行 make test。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid.h"
+#include "pid_q.h"
+#include "test_common.h"
+#include <math.h>
+
+/* 开环比较：两者输入相同的 Q16.16 量化序列，返回 max |u - u_q| / (1 + |u|)
+ * 设定值每 0.1 秒在 ±1 之间切换，测量值为 2 Hz 正弦，输出范围足够大，只有 Kd / Ts 很大时才饱和 */
+static float open_loop_diff(float Kp, float Ki, float Kd, float Ts, float tau)
+{
+    PIDController pid;
+    PIDControllerQ pid_q;
+    pid_init(&pid, Kp, Ki, Kd, Ts, -30000.0f, 30000.0f, tau);
+    pid_q_init(&pid_q, Kp, Ki, Kd, Ts, -30000.0f, 30000.0f, tau);
+
+    float max_diff = 0.0f;
+    int ticks      = (int)(0.5f / Ts + 0.5f);
+    for (int k = 0; k < ticks; k++)
+    {
+        float t           = k * Ts;
+        q16_t setpoint    = ((int)(t * 10.0f) & 1) ? -Q16_ONE : Q16_ONE;
+        q16_t measurement = Q16_FROM_FLOAT(0.8f * sinf(2.0f * 3.14159265f * 2.0f * t));
+        float u           = pid_update(&pid, Q16_TO_FLOAT(setpoint), Q16_TO_FLOAT(measurement));
+        float u_q         = Q16_TO_FLOAT(pid_q_update(&pid_q, setpoint, measurement));
+        float diff        = fabsf(u - u_q) / (1.0f + fabsf(u));
+        max_diff          = diff > max_diff ? diff : max_diff;
+    }
+    return max_diff;
+}
+
+static void test_equivalence(void)
+{
+    static const float periods[] = {1e-2f, 1e-3f, 1e-4f};
+    for (unsigned i = 0; i < sizeof(periods) / sizeof(periods[0]); i++)
+    {
+        float Ts = periods[i];
+        char name[64];
+        // PI，Ki = 1：Ts = 0.1 ms 时 0.5·Ki·Ts ≈ 3.3 LSB
+        snprintf(name, sizeof(name), "PI           Ts=%g", Ts);
+        test_range(name, open_loop_diff(0.5f, 1.0f, 0.0f, Ts, 0.0f), 0.0, 1e-3);
+        // 误差差分：Kd / Ts 最大 5e4，超过 Q16.16 的整数范围，设定值阶跃时输出饱和
+        snprintf(name, sizeof(name), "PID          Ts=%g", Ts);
+        test_range(name, open_loop_diff(0.5f, 1.0f, 5.0f, Ts, 0.0f), 0.0, 1e-3);
+        // 滤波微分：kd_filter = 2·Kd / ((2τ + Ts)·Ts)，Ts = 0.1 ms 时约 4.9e4
+        snprintf(name, sizeof(name), "PID filtered Ts=%g", Ts);
+        test_range(name, open_loop_diff(0.5f, 1.0f, 0.01f, Ts, 0.002f), 0.0, 1e-3);
+    }
+}
+
+/* 恒定误差下积分 1 秒：浮点为 Ki·e·t，定点不能因系数量化偏离 */
+static void test_integrator_accuracy(void)
+{
+    const float Ts = 1e-4f, Ki = 1.0f, error = 0.25f;
+    PIDController pid;
+    PIDControllerQ pid_q;
+    pid_init(&pid, 0.0f, Ki, 0.0f, Ts, -10.0f, 10.0f, 0.0f);
+    pid_q_init(&pid_q, 0.0f, Ki, 0.0f, Ts, -10.0f, 10.0f, 0.0f);
+    float u = 0.0f, u_q = 0.0f;
+    for (int k = 0; k < 10000; k++)
+    {
+        u   = pid_update(&pid, error, 0.0f);
+        u_q = Q16_TO_FLOAT(pid_q_update(&pid_q, Q16_FROM_FLOAT(error), 0));
+    }
+    test_range("integral after 1 s, float", u, 0.2499, 0.2501);
+    test_range("integral after 1 s, relative error", fabsf(u_q - u) / u, 0.0, 1e-3);
+}
+
+/* Kd / Ts = 1e6 时微分乘积超出 Q16.16，输出应饱和到与浮点相同的一侧 */
+static void test_derivative_saturation(void)
+{
+    const float Ts = 1e-4f;
+    PIDControllerQ pid_q;
+    pid_q_init(&pid_q, 0.0f, 0.0f, 100.0f, Ts, -30000.0f, 30000.0f, 0.0f);
+    pid_q_update(&pid_q, 0, 0);
+    q16_t up   = pid_q_update(&pid_q, Q16_FROM_FLOAT(1.0f), 0);
+    q16_t down = pid_q_update(&pid_q, Q16_FROM_FLOAT(-1.0f), 0);
+    test_range("derivative +step saturates high", Q16_TO_FLOAT(up), 29999.0, 30000.0);
+    test_range("derivative -step saturates low", Q16_TO_FLOAT(down), -30000.0, -29999.0);
+}
+
+int main(void)
+{
+    test_equivalence();
+    test_integrator_accuracy();
+    test_derivative_saturation();
+    return test_summary("test_pid_q");
+}
@@ -0,0 +1,337 @@
+/**
+ * @file    test_pid_regression.c
+ * @brief   PID 控制器阶跃响应回归测试
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 用 pid_plant 的对象模型闭环驱动 pid / pid_q / pid_bank / pid_velocity /
+ *          pid_schedule / pid_cascade，由 pid_metrics 统计上升时间、超调量、调节时间和 IAE，
+ *          与固定阈值比较：
+ *          1. FOPDT 对象（K = 2，τ = 0.5 s，L = 0.05 s，100 Hz）+ SIMC PI，
+ *             位置式、定点、增量式三种实现分别闭环；
+ *          2. pid_bank 的每个回路与同参数的 pid_update 逐拍比较输出；
+ *          3. 增益调度：断点和区间中点的插值，以及按对象增益调度的闭环；
+ *          4. 带减速器的直流电机 + 编码器量化（100 Hz 测速）+ PI 速度环，
+ *             减速比和编码器计数取自 encoder_speed.h；
+ *          5. 同一速度环改用二自由度（b = 0.5，c = 0）+ 静态前馈，经 pid_update_ff_dt
+ *             按抖动的实测周期更新，超调量不大于单自由度 PI；
+ *          6. 串级位置环（外环 2 分频）驱动同一电机转到 360°。
+ *          阈值按当前实现的实测值留出余量，算法改动使指标明显变差时测试失败。
+ *
+ * @note    在 test 目录下运行 make test。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "encoder_speed.h"
+#include "pid.h"
+#include "pid_bank.h"
+#include "pid_cascade.h"
+#include "pid_metrics.h"
+#include "pid_plant.h"
+#include "pid_q.h"
+#include "pid_schedule.h"
+#include "pid_velocity.h"
+#include "test_common.h"
+#include <math.h>
+
+// FOPDT 对象和 SIMC PI 参数（τc = θ）：Kc = τ / (K·2θ) = 2.5，Ti = min(τ, 8θ) = 0.4 s
+#define PLANT_GAIN 2.0f
+#define PLANT_TAU 0.5f
+#define PLANT_DEAD_TIME 0.05f
+#define LOOP_TS 0.01f
+#define LOOP_KP 2.5f
+#define LOOP_KI (LOOP_KP / 0.4f)
+#define LOOP_TICKS 500 // 5 秒
+#define SETPOINT 1.0f
+
+// 直流电机：减速比和电机轴每转计数与固件相同，100 Hz 测速
+#define MOTOR_TS 0.01f
+#define MOTOR_GEAR ((float)REDUCTION_RATIO)
+#define MOTOR_COUNTS_PER_REV (PULSES_PER_REVOLUTION * FREQUENCY_DOUBLING_COEFFICIENT)
+#define MOTOR_SETPOINT 1000.0f // 输出轴转/分
+#define MOTOR_VOLTAGE 12.0f
+#define MOTOR_KP 0.004f
+#define MOTOR_KI 0.08f
+
+/* 打印并检查一次阶跃响应的指标 */
+static void check_metrics(const char* name, const PIDMetrics* m, float rise_max,
+                          float overshoot_max, float settling_max, float iae_max)
+{
+    char label[64];
+    snprintf(label, sizeof(label), "%s rise time (s)", name);
+    test_range(label, pid_metrics_rise_time(m), 0.0, rise_max);
+    snprintf(label, sizeof(label), "%s overshoot (%%)", name);
+    test_range(label, pid_metrics_overshoot(m), 0.0, overshoot_max);
+    snprintf(label, sizeof(label), "%s settling time (s)", name);
+    test_range(label, pid_metrics_settling_time(m), 0.0, settling_max);
+    snprintf(label, sizeof(label), "%s IAE", name);
+    test_range(label, m->iae, 0.0, iae_max);
+}
+
+/* 浮点 PID 闭环 FOPDT */
+static void test_fopdt_float(void)
+{
+    PIDController pid;
+    PIDPlantFOPDT plant;
+    PIDMetrics metrics;
+    pid_init(&pid, LOOP_KP, LOOP_KI, 0.0f, LOOP_TS, -2.0f, 2.0f, 0.0f);
+    pid_plant_fopdt_init(&plant, PLANT_GAIN, PLANT_TAU, PLANT_DEAD_TIME, LOOP_TS);
+    pid_metrics_init(&metrics, 0.0f, SETPOINT, 0.02f, LOOP_TS);
+    float y = 0.0f;
+    for (int k = 0; k < LOOP_TICKS; k++)
+    {
+        float u = pid_update(&pid, SETPOINT, y);
+        y       = pid_plant_fopdt_step(&plant, u);
+        pid_metrics_update(&metrics, y, u <= pid.out_min || u >= pid.out_max);
+    }
+    check_metrics("pid   fopdt", &metrics, 0.20f, 5.0f, 1.0f, 0.17f);
+}
+
+/* 定点 PID 闭环 FOPDT，指标应与浮点版本基本一致 */
+static void test_fopdt_fixed(void)
+{
+    PIDControllerQ pid;
+    PIDPlantFOPDT plant;
+    PIDMetrics metrics;
+    pid_q_init(&pid, LOOP_KP, LOOP_KI, 0.0f, LOOP_TS, -2.0f, 2.0f, 0.0f);
+    pid_plant_fopdt_init(&plant, PLANT_GAIN, PLANT_TAU, PLANT_DEAD_TIME, LOOP_TS);
+    pid_metrics_init(&metrics, 0.0f, SETPOINT, 0.02f, LOOP_TS);
+    float y = 0.0f;
+    for (int k = 0; k < LOOP_TICKS; k++)
+    {
+        q16_t u = pid_q_update(&pid, Q16_FROM_FLOAT(SETPOINT), Q16_FROM_FLOAT(y));
+        y       = pid_plant_fopdt_step(&plant, Q16_TO_FLOAT(u));
+        pid_metrics_update(&metrics, y, u <= pid.out_min || u >= pid.out_max);
+    }
+    check_metrics("pid_q fopdt", &metrics, 0.20f, 5.0f, 1.0f, 0.17f);
+}
+
+/* 增量式 PI 闭环 FOPDT：积分为矩形公式，饱和时控制量停在边界上 */
+static void test_fopdt_velocity(void)
+{
+    PIDVelocity pid;
+    PIDPlantFOPDT plant;
+    PIDMetrics metrics;
+    pid_velocity_init(&pid, LOOP_KP, LOOP_KI, 0.0f, LOOP_TS, -2.0f, 2.0f, 0.0f);
+    pid_plant_fopdt_init(&plant, PLANT_GAIN, PLANT_TAU, PLANT_DEAD_TIME, LOOP_TS);
+    pid_metrics_init(&metrics, 0.0f, SETPOINT, 0.02f, LOOP_TS);
+    float y = 0.0f;
+    for (int k = 0; k < LOOP_TICKS; k++)
+    {
+        float u = pid_velocity_update(&pid, SETPOINT, y);
+        y       = pid_plant_fopdt_step(&plant, u);
+        pid_metrics_update(&metrics, y, u <= pid.out_min || u >= pid.out_max);
+    }
+    // 初始比例冲击被限幅截掉后不会像位置式那样由积分器补回，上升比位置式慢
+    check_metrics("pid_velocity fopdt", &metrics, 0.60f, 5.0f, 1.5f, 0.25f);
+}
+
+/* 控制器组：每个回路闭环各自的对象，并与同参数的 pid_update 逐拍比较 */
+static void test_bank(void)
+{
+    enum
+    {
+        LOOPS = 4
+    };
+    static const float gain_scale[LOOPS] = {1.0f, 0.8f, 1.2f, 0.6f};
+    static const float tau[LOOPS]        = {0.0f, 0.02f, 0.0f, 0.05f};
+    // tau > 0 的回路走滤波微分（kd_filter），tau = 0 的回路走误差差分（kd_diff）
+    static const float kd[LOOPS] = {0.0f, 0.0002f, 0.01f, 0.0005f};
+    PIDBank bank;
+    PIDController reference[LOOPS];
+    PIDPlantFOPDT plant[LOOPS];
+    PIDMetrics metrics[LOOPS];
+    float setpoints[LOOPS], measurements[LOOPS], outputs[LOOPS];
+
+    pid_bank_init(&bank);
+    for (int i = 0; i < LOOPS; i++)
+    {
+        float kp = LOOP_KP * gain_scale[i], ki = LOOP_KI * gain_scale[i];
+        pid_bank_add(&bank, kp, ki, kd[i], LOOP_TS, -2.0f, 2.0f, tau[i]);
+        pid_init(&reference[i], kp, ki, kd[i], LOOP_TS, -2.0f, 2.0f, tau[i]);
+        pid_plant_fopdt_init(&plant[i], PLANT_GAIN, PLANT_TAU, PLANT_DEAD_TIME, LOOP_TS);
+        pid_metrics_init(&metrics[i], 0.0f, SETPOINT, 0.02f, LOOP_TS);
+        setpoints[i]    = SETPOINT;
+        measurements[i] = 0.0f;
+    }
+
+    float max_diff = 0.0f;
+    for (int k = 0; k < LOOP_TICKS; k++)
+    {
+        pid_bank_update(&bank, setpoints, measurements, outputs);
+        for (int i = 0; i < LOOPS; i++)
+        {
+            float expected  = pid_update(&reference[i], setpoints[i], measurements[i]);
+            float diff      = fabsf(outputs[i] - expected);
+            max_diff        = diff > max_diff ? diff : max_diff;
+            measurements[i] = pid_plant_fopdt_step(&plant[i], outputs[i]);
+            pid_metrics_update(&metrics[i], measurements[i],
+                               outputs[i] <= -2.0f || outputs[i] >= 2.0f);
+        }
+    }
+    test_range("pid_bank max |bank - pid_update|", max_diff, 0.0, 1e-5);
+    for (int i = 0; i < LOOPS; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "pid_bank[%d] fopdt", i);
+        check_metrics(name, &metrics[i], 0.35f, 10.0f, 1.5f, 0.23f);
+    }
+}
+
+/* 增益调度：按对象增益 K 给出 SIMC PI（Kc = 2.5 / K·2，Ti = 0.4 s），查表与闭环 */
+static void test_schedule(void)
+{
+    static const PIDGainPoint table[] = {
+        {1.0f, 5.0f, 12.5f, 0.0f},
+        {2.0f, 2.5f, 6.25f, 0.0f},
+        {4.0f, 1.25f, 3.125f, 0.01f},
+    };
+    PIDGainSchedule schedule;
+    pid_schedule_init(&schedule, table, sizeof(table) / sizeof(table[0]));
+    // 断点、区间中点、两端之外，以及增量查找时跨区间回退
+    static const float x[]  = {2.0f, 3.0f, 0.5f, 1.5f, 9.0f, 1.0f};
+    static const float kp[] = {2.5f, 1.875f, 5.0f, 3.75f, 1.25f, 5.0f};
+    static const float kd[] = {0.0f, 0.005f, 0.0f, 0.0f, 0.01f, 0.0f};
+    float max_error         = 0.0f;
+    for (unsigned i = 0; i < sizeof(x) / sizeof(x[0]); i++)
+    {
+        float Kp, Ki, Kd;
+        pid_schedule_lookup(&schedule, x[i], &Kp, &Ki, &Kd);
+        max_error = fmaxf(max_error, fabsf(Kp - kp[i]));
+        max_error = fmaxf(max_error, fabsf(Ki - 2.5f * kp[i]));
+        max_error = fmaxf(max_error, fabsf(Kd - kd[i]));
+    }
+    test_range("pid_schedule max |lookup - table|", max_error, 0.0, 1e-6);
+
+    // 对象增益在阶跃途中从 2 线性升到 3，每拍按当前增益调度，指标与固定 K = 2 时接近
+    PIDController pid;
+    PIDPlantFOPDT plant;
+    PIDMetrics metrics;
+    pid_init(&pid, LOOP_KP, LOOP_KI, 0.0f, LOOP_TS, -2.0f, 2.0f, 0.0f);
+    pid_plant_fopdt_init(&plant, PLANT_GAIN, PLANT_TAU, PLANT_DEAD_TIME, LOOP_TS);
+    pid_metrics_init(&metrics, 0.0f, SETPOINT, 0.02f, LOOP_TS);
+    float y = 0.0f;
+    for (int k = 0; k < LOOP_TICKS; k++)
+    {
+        plant.gain = PLANT_GAIN + fminf(k * LOOP_TS, 1.0f);
+        pid_schedule_apply(&schedule, &pid, plant.gain);
+        float u = pid_update(&pid, SETPOINT, y);
+        y       = pid_plant_fopdt_step(&plant, u);
+        pid_metrics_update(&metrics, y, u <= pid.out_min || u >= pid.out_max);
+    }
+    check_metrics("pid_schedule fopdt", &metrics, 0.20f, 5.0f, 1.0f, 0.17f);
+}
+
+/* 初始化直流电机和编码器：机械时间常数 J·R / (Ke·Kt) ≈ 20 ms，电气时间常数 L / R = 0.25 ms，
+ * 空载时约 5800 rpm / 12 V */
+static void motor_init(PIDPlantDCMotor* motor, PIDPlantEncoder* encoder)
+{
+    pid_plant_dc_motor_init(motor, 2.0f, 0.5e-3f, 0.0045f, 0.0045f, 2e-7f, 1e-7f, MOTOR_GEAR,
+                            MOTOR_TS, 20);
+    pid_plant_encoder_init(encoder, MOTOR_COUNTS_PER_REV, 0.0f);
+}
+
+/* 与固件一致：本拍计数差换算为输出轴转速（转/分） */
+static float motor_speed(int32_t counts)
+{
+    return counts / MOTOR_COUNTS_PER_REV / MOTOR_TS * 60.0f / MOTOR_GEAR;
+}
+
+/* 直流电机速度环：编码器量化测速，PI 输出为电枢电压 */
+static void test_dc_motor(PIDMetrics* metrics)
+{
+    PIDPlantDCMotor motor;
+    PIDPlantEncoder encoder;
+    PIDController pid;
+    motor_init(&motor, &encoder);
+    pid_init(&pid, MOTOR_KP, MOTOR_KI, 0.0f, MOTOR_TS, -MOTOR_VOLTAGE, MOTOR_VOLTAGE, 0.0f);
+    pid_metrics_init(metrics, 0.0f, MOTOR_SETPOINT, 0.05f, MOTOR_TS);
+    float speed = 0.0f;
+    for (int k = 0; k < 200; k++)
+    {
+        float u = pid_update(&pid, MOTOR_SETPOINT, speed);
+        pid_plant_dc_motor_step(&motor, u, 0.0f);
+        speed = motor_speed(pid_plant_encoder_read(&encoder, motor.angle));
+        pid_metrics_update(metrics, speed, u <= -MOTOR_VOLTAGE || u >= MOTOR_VOLTAGE);
+    }
+    check_metrics("pid   dc motor", metrics, 0.05f, 10.0f, 0.3f, 60.0f);
+}
+
+/* 同一速度环：二自由度（b = 0.5，c = 0）+ 静态前馈（空载电压 / 转速），
+ * 实测周期在标称值 ±2% 之间交替，经 pid_update_ff_dt 缩放积分项 */
+static void test_dc_motor_2dof(const PIDMetrics* one_dof)
+{
+    PIDPlantDCMotor motor;
+    PIDPlantEncoder encoder;
+    PIDController pid, reference, nominal;
+    PIDMetrics metrics;
+    motor_init(&motor, &encoder);
+    pid_init(&pid, MOTOR_KP, MOTOR_KI, 0.0f, MOTOR_TS, -MOTOR_VOLTAGE, MOTOR_VOLTAGE, 0.0f);
+    pid_set_setpoint_weights(&pid, 0.5f, 0.0f);
+    pid_metrics_init(&metrics, 0.0f, MOTOR_SETPOINT, 0.05f, MOTOR_TS);
+    const float feedforward = MOTOR_SETPOINT * MOTOR_VOLTAGE / 5800.0f;
+    float speed = 0.0f, max_nominal_diff = 0.0f;
+    for (int k = 0; k < 200; k++)
+    {
+        // 实测周期等于标称值时与 pid_update_ff 逐位相同
+        reference        = pid;
+        nominal          = pid;
+        float expected   = pid_update_ff(&reference, MOTOR_SETPOINT, speed, feedforward);
+        float exact      = pid_update_ff_dt(&nominal, MOTOR_SETPOINT, speed, feedforward, MOTOR_TS);
+        max_nominal_diff = fmaxf(max_nominal_diff, fabsf(exact - expected));
+        float dt         = (k & 1) ? 1.02f * MOTOR_TS : 0.98f * MOTOR_TS;
+        float u          = pid_update_ff_dt(&pid, MOTOR_SETPOINT, speed, feedforward, dt);
+        pid_plant_dc_motor_step(&motor, u, 0.0f);
+        speed = motor_speed(pid_plant_encoder_read(&encoder, motor.angle));
+        pid_metrics_update(&metrics, speed, u <= -MOTOR_VOLTAGE || u >= MOTOR_VOLTAGE);
+    }
+    test_range("pid_update_ff_dt nominal dt vs pid_update_ff", max_nominal_diff, 0.0, 0.0);
+    check_metrics("pid 2dof+ff dc motor", &metrics, 0.05f, 10.0f, 0.3f, 60.0f);
+    test_check("2dof+ff overshoot <= 1dof",
+               pid_metrics_overshoot(&metrics) <= pid_metrics_overshoot(one_dof));
+}
+
+/* 串级位置环：外环 P（度 -> 转/分，2 分频），内环为上面的 PI 速度环，目标 360° */
+static void test_dc_motor_cascade(void)
+{
+    const float target = 360.0f;
+    PIDPlantDCMotor motor;
+    PIDPlantEncoder encoder;
+    PIDController outer, inner;
+    PIDCascade cascade;
+    PIDMetrics metrics;
+    motor_init(&motor, &encoder);
+    pid_init(&outer, 4.0f, 0.0f, 0.0f, 2.0f * MOTOR_TS, -MOTOR_SETPOINT, MOTOR_SETPOINT, 0.0f);
+    pid_init(&inner, MOTOR_KP, MOTOR_KI, 0.0f, MOTOR_TS, -MOTOR_VOLTAGE, MOTOR_VOLTAGE, 0.0f);
+    pid_cascade_init(&cascade, &outer, &inner, 2, 1);
+    pid_metrics_init(&metrics, 0.0f, target, 0.02f, MOTOR_TS);
+    float speed = 0.0f, angle = 0.0f;
+    int32_t position = 0;
+    for (int k = 0; k < 300; k++)
+    {
+        float u = pid_cascade_update(&cascade, target, angle, speed);
+        pid_plant_dc_motor_step(&motor, u, 0.0f);
+        int32_t counts = pid_plant_encoder_read(&encoder, motor.angle);
+        position += counts;
+        speed = motor_speed(counts);
+        angle = COUNTS_TO_DEGREES((float)position);
+        pid_metrics_update(&metrics, angle, u <= -MOTOR_VOLTAGE || u >= MOTOR_VOLTAGE);
+    }
+    check_metrics("pid_cascade dc motor", &metrics, 0.15f, 5.0f, 0.4f, 25.0f);
+}
+
+int main(void)
+{
+    PIDMetrics one_dof;
+    test_fopdt_float();
+    test_fopdt_fixed();
+    test_fopdt_velocity();
+    test_bank();
+    test_schedule();
+    test_dc_motor(&one_dof);
+    test_dc_motor_2dof(&one_dof);
+    test_dc_motor_cascade();
+    return test_summary("test_pid_regression");
+}
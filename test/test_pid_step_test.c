@@ -0,0 +1,119 @@
+/**
+ * @file    test_pid_step_test.c
+ * @brief   开环阶跃测试与 FOPDT 拟合的合成数据验证
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 用参数已知的 pid_plant FOPDT 对象驱动 pid_step_test，检查：
+ *          1. 两点法拟合出的 K、τ、θ 与真实值的误差（100 Hz 不抽取，1 kHz 每 10 拍记录一次）；
+ *          2. SIMC / IMC 整定结果与按拟合值手算的公式一致，并与按真实参数算出的增益接近；
+ *          3. 记录时长不足以到达稳态时拟合失败，而不是给出偏小的增益和时间常数。
+ *
+ * @note    在 test 目录下运行 make test。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "pid_plant.h"
+#include "pid_step_test.h"
+#include "test_common.h"
+#include <math.h>
+
+#define PLANT_GAIN 2.0f
+#define PLANT_TAU 0.5f
+
+/* 以 FOPDT 对象运行一次完整的阶跃测试（u 从 0.2 阶跃到 0.7），返回拟合是否成功 */
+static uint8_t run_step_test(PIDStepTest* test, float dead_time, float Ts, uint16_t decimation)
+{
+    PIDPlantFOPDT plant;
+    pid_plant_fopdt_init(&plant, PLANT_GAIN, PLANT_TAU, dead_time, Ts);
+    pid_step_test_init(test, 0.2f, 0.7f, Ts, (uint32_t)(5.0f / Ts), decimation);
+    float y = 0.0f;
+    // 对象从 0 开始响应 u0，基线 5 秒（10τ），阶跃前已稳定
+    for (uint32_t k = 0; k < 100000 && test->state != PID_STEP_TEST_DONE; k++)
+    {
+        float u = pid_step_test_update(test, y);
+        y       = pid_plant_fopdt_step(&plant, u);
+    }
+    return pid_step_test_fit(test);
+}
+
+/* 相对误差 */
+static double relative_error(float value, float truth)
+{
+    return fabsf(value - truth) / fabsf(truth);
+}
+
+/* 检查拟合结果和两种整定规则的增益 */
+static void check_fit(const char* name, float dead_time, float Ts, uint16_t decimation)
+{
+    PIDStepTest test;
+    char label[64];
+    snprintf(label, sizeof(label), "%s fit succeeds", name);
+    test_check(label, run_step_test(&test, dead_time, Ts, decimation));
+
+    snprintf(label, sizeof(label), "%s K relative error", name);
+    test_range(label, relative_error(test.K, PLANT_GAIN), 0.0, 0.03);
+    snprintf(label, sizeof(label), "%s tau relative error", name);
+    test_range(label, relative_error(test.tau, PLANT_TAU), 0.0, 0.10);
+    // θ 的误差主要来自记录间隔的量化，按记录间隔给容差
+    snprintf(label, sizeof(label), "%s theta error (s)", name);
+    test_range(label, fabsf(test.theta - dead_time), 0.0, 2.0 * test.Ts);
+
+    // SIMC PI（τc = θ）：Kc = τ / (K·2θ)，Ti = min(τ, 8θ)
+    float Kp, Ki, Kd;
+    float K = test.K, tau = test.tau, theta = test.theta;
+    pid_step_test_gains(&test, PID_FOPDT_SIMC, &Kp, &Ki, &Kd);
+    float simc_kp = tau / (K * 2.0f * theta);
+    float simc_ki = simc_kp / fminf(tau, 8.0f * theta);
+    snprintf(label, sizeof(label), "%s SIMC Kp matches formula", name);
+    test_range(label, relative_error(Kp, simc_kp), 0.0, 1e-5);
+    snprintf(label, sizeof(label), "%s SIMC Ki matches formula", name);
+    test_range(label, relative_error(Ki, simc_ki), 0.0, 1e-5);
+    snprintf(label, sizeof(label), "%s SIMC Kd is zero", name);
+    test_check(label, Kd == 0.0f);
+    // 与按真实参数算出的增益比较
+    float true_kp = PLANT_TAU / (PLANT_GAIN * 2.0f * dead_time);
+    float true_ki = true_kp / fminf(PLANT_TAU, 8.0f * dead_time);
+    snprintf(label, sizeof(label), "%s SIMC Kp vs true plant", name);
+    test_range(label, relative_error(Kp, true_kp), 0.0, 0.10);
+    snprintf(label, sizeof(label), "%s SIMC Ki vs true plant", name);
+    test_range(label, relative_error(Ki, true_ki), 0.0, 0.10);
+
+    // IMC PID：λ = max(θ, 0.2τ, Ts)，Kc = (τ + θ/2) / (K·(λ + θ/2))，
+    //          Ti = τ + θ/2，Td = τθ / (2τ + θ)
+    pid_step_test_gains(&test, PID_FOPDT_IMC, &Kp, &Ki, &Kd);
+    float lambda = fmaxf(fmaxf(theta, 0.2f * tau), test.Ts);
+    float imc_kp = (tau + 0.5f * theta) / (K * (lambda + 0.5f * theta));
+    float imc_ki = imc_kp / (tau + 0.5f * theta);
+    float imc_kd = imc_kp * tau * theta / (2.0f * tau + theta);
+    snprintf(label, sizeof(label), "%s IMC Kp matches formula", name);
+    test_range(label, relative_error(Kp, imc_kp), 0.0, 1e-5);
+    snprintf(label, sizeof(label), "%s IMC Ki matches formula", name);
+    test_range(label, relative_error(Ki, imc_ki), 0.0, 1e-5);
+    snprintf(label, sizeof(label), "%s IMC Kd matches formula", name);
+    test_range(label, relative_error(Kd, imc_kd), 0.0, 1e-5);
+}
+
+/* 记录时长远小于对象的调节时间：拟合必须失败 */
+static void check_unsettled(void)
+{
+    PIDStepTest test;
+    // 1 kHz、每 2 拍记录一次：阶跃后只记录 0.48 秒，不到 1 个时间常数
+    uint8_t ok = run_step_test(&test, 0.05f, 0.001f, 2);
+    test_check("unsettled record is rejected", !ok && test.state == PID_STEP_TEST_FAILED);
+    float Kp, Ki, Kd;
+    ok = pid_step_test_gains(&test, PID_FOPDT_SIMC, &Kp, &Ki, &Kd);
+    test_check("no gains after rejected fit", !ok);
+}
+
+int main(void)
+{
+    // 100 Hz，θ = 0.1 s（10 拍），记录 2.4 秒
+    check_fit("100 Hz", 0.1f, 0.01f, 1);
+    // 1 kHz，θ = 0.05 s（50 拍），每 10 拍记录一次，记录 2.4 秒
+    check_fit("1 kHz /10", 0.05f, 0.001f, 10);
+    check_unsettled();
+    return test_summary("test_pid_step_test");
+}
@@ -0,0 +1,160 @@
+/**
+ * @file    test_speed_observer.c
+ * @brief   编码器速度观测器（α-β 与卡尔曼）与一阶低通测速的模拟编码器对比测试
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 按已知的速度曲线生成真实位置，经 pid_plant_encoder 量化成整数计数，
+ *          累加成会回绕的 16 位计数器值，按默认 10 Hz 节拍分别送入：
+ *          1. 固件的默认测速：计数差 + 一阶低通（encoder_speed_measure，
+ *             SPEED_EMA_COEFFICIENT），作为基准；
+ *          2. α-β 观测器，增益为固件默认值 OBSERVER_ALPHA / OBSERVER_BETA；
+ *          3. 稳态卡尔曼观测器，噪声为固件默认值 KALMAN_ACCEL_NOISE（按节拍换算，
+ *             与 Motor_Set_Speed_Estimator 相同）/ KALMAN_MEAS_NOISE。
+ *          速度曲线：匀加速 → 匀速 → 正弦变速，中途跨过计数器的 65535 → 0 回绕。
+ *          检查匀速段的速度噪声（RMS）、匀加速段的平均滞后（节拍）和全程 RMS 误差，
+ *          并要求两种观测器的噪声和滞后都小于基准。
+ *
+ * @note    在 test 目录下运行 make test。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "encoder_speed.h"
+#include "pid_plant.h"
+#include "speed_observer.h"
+#include "test_common.h"
+#include <math.h>
+
+#define RAMP_TICKS 200    // 匀加速段
+#define CONST_TICKS 300   // 匀速段
+#define SINE_TICKS 500    // 正弦变速段
+#define TOP_SPEED 13.3    // 计数/节拍，非整数，计数差在 13 和 14 之间跳变
+#define START_COUNT 60000 // 起始位置，匀速段跨过 16 位回绕
+#define CONTROL_PERIOD 0.1f // 与 encoder.h 中 MOTOR_CONTROL_PERIOD 相同
+
+enum
+{
+    EST_EMA = 0,
+    EST_ALPHA_BETA,
+    EST_KALMAN,
+    EST_COUNT
+};
+
+static const char* const est_names[EST_COUNT] = {"ema", "alpha-beta", "kalman"};
+// 阈值：匀速段 RMS 范围、匀加速段滞后范围、全程 RMS 上限
+// 一阶低通的 RMS 下限保证量化噪声确实存在，滞后为 (1 - a) / a + 1/2 ≈ 2.83 拍；
+// α-β 的理论加速度滞后为 α/β - 1/2 ≈ 2.1 拍
+static const double rms_const_min[EST_COUNT] = {0.05, 0.0, 0.0};
+static const double rms_const_max[EST_COUNT] = {0.15, 0.08, 0.09};
+static const double lag_min[EST_COUNT]       = {2.5, 1.8, 1.6};
+static const double lag_max[EST_COUNT]       = {3.2, 2.5, 2.3};
+static const double rms_all_max[EST_COUNT]   = {0.35, 0.26, 0.25};
+
+/* 第 k 拍的真实速度（计数/节拍） */
+static double true_velocity(int k)
+{
+    if (k < RAMP_TICKS)
+    {
+        return TOP_SPEED * k / RAMP_TICKS;
+    }
+    if (k < RAMP_TICKS + CONST_TICKS)
+    {
+        return TOP_SPEED;
+    }
+    // 周期 100 拍、幅值 3 计数/节拍的正弦变速
+    int t = k - RAMP_TICKS - CONST_TICKS;
+    return TOP_SPEED + 3.0 * sin(2.0 * 3.14159265358979 * t / 100.0);
+}
+
+int main(void)
+{
+    const int ticks = RAMP_TICKS + CONST_TICKS + SINE_TICKS;
+    PIDPlantEncoder encoder;
+    SpeedObserver alpha_beta, kalman;
+    EncoderSpeed ema;
+    double position = START_COUNT + 0.5;
+    uint16_t count  = START_COUNT;
+    pid_plant_encoder_init(&encoder, 1.0f, (float)position);
+    // 速度单位取计数/节拍：counts_to_speed = Ts，比例系数为 Ts·fs / 2^16
+    encoder_speed_init(&ema, CONTROL_PERIOD);
+    encoder_speed_set_rate(&ema, 1.0f / CONTROL_PERIOD, 72000000);
+    speed_observer_init_alpha_beta(&alpha_beta, OBSERVER_ALPHA, OBSERVER_BETA);
+    speed_observer_init_kalman(&kalman, KALMAN_ACCEL_NOISE * CONTROL_PERIOD * CONTROL_PERIOD,
+                               KALMAN_MEAS_NOISE);
+    speed_observer_reset(&alpha_beta, count);
+    speed_observer_reset(&kalman, count);
+
+    // 匀速段噪声、匀加速段滞后、全程误差，跳过开头 20 拍的收敛过程
+    double const_sq[EST_COUNT] = {0}, ramp_lag[EST_COUNT] = {0}, all_sq[EST_COUNT] = {0};
+    int const_n = 0, ramp_n = 0, all_n = 0;
+    int wrapped = 0;
+    for (int k = 0; k < ticks; k++)
+    {
+        // 本拍内速度按梯形积分，测量的是节拍结束时的位置
+        double v0 = true_velocity(k), v1 = true_velocity(k + 1);
+        position += 0.5 * (v0 + v1);
+        uint16_t last = count;
+        count         = (uint16_t)(count + pid_plant_encoder_read(&encoder, (float)position));
+        wrapped |= count < last;
+        speed_observer_update(&alpha_beta, count);
+        speed_observer_update(&kalman, count);
+
+        double estimate[EST_COUNT];
+        estimate[EST_EMA]        = encoder_speed_measure(&ema, (int16_t)(count - last), 0);
+        estimate[EST_ALPHA_BETA] = speed_observer_velocity(&alpha_beta);
+        estimate[EST_KALMAN]     = speed_observer_velocity(&kalman);
+        if (k < 20)
+        {
+            continue;
+        }
+        for (int e = 0; e < EST_COUNT; e++)
+        {
+            double error = estimate[e] - v1;
+            all_sq[e] += error * error;
+            if (k >= RAMP_TICKS + 20 && k < RAMP_TICKS + CONST_TICKS)
+            {
+                const_sq[e] += error * error;
+            }
+            if (k < RAMP_TICKS - 1)
+            {
+                // 匀加速时滞后 = 速度误差 / 加速度（节拍）
+                ramp_lag[e] += -error / (TOP_SPEED / RAMP_TICKS);
+            }
+        }
+        all_n++;
+        const_n += k >= RAMP_TICKS + 20 && k < RAMP_TICKS + CONST_TICKS;
+        ramp_n += k < RAMP_TICKS - 1;
+    }
+
+    test_check("encoder count wrapped past 65535", wrapped);
+    double rms_const[EST_COUNT], lag[EST_COUNT], rms_all[EST_COUNT];
+    for (int e = 0; e < EST_COUNT; e++)
+    {
+        rms_const[e] = sqrt(const_sq[e] / const_n);
+        lag[e]       = ramp_lag[e] / ramp_n;
+        rms_all[e]   = sqrt(all_sq[e] / all_n);
+        char label[64];
+        snprintf(label, sizeof(label), "%s constant-speed RMS", est_names[e]);
+        test_range(label, rms_const[e], rms_const_min[e], rms_const_max[e]);
+        snprintf(label, sizeof(label), "%s ramp lag (ticks)", est_names[e]);
+        test_range(label, lag[e], lag_min[e], lag_max[e]);
+        snprintf(label, sizeof(label), "%s overall RMS", est_names[e]);
+        test_range(label, rms_all[e], 0.0, rms_all_max[e]);
+    }
+    // 默认参数下两种观测器都必须同时比固件的一阶低通更安静、滞后更小，否则不值得切换
+    for (int e = EST_ALPHA_BETA; e < EST_COUNT; e++)
+    {
+        char label[64];
+        snprintf(label, sizeof(label), "%s quieter than ema", est_names[e]);
+        test_check(label, rms_const[e] < rms_const[EST_EMA]);
+        snprintf(label, sizeof(label), "%s lags less than ema", est_names[e]);
+        test_check(label, lag[e] < lag[EST_EMA]);
+    }
+    // 过程噪声大（原默认值 500 计数/秒²，10 Hz）时稳态卡尔曼的速度增益超过 1，不能被截断成 1
+    SpeedObserver fast;
+    speed_observer_init_kalman(&fast, 5.0f, KALMAN_MEAS_NOISE);
+    test_range("high-noise kalman beta", (double)fast.beta / (1L << SPEED_OBSERVER_Q), 1.5, 2.0);
+    return test_summary("test_speed_observer");
+}
@@ -0,0 +1,203 @@
+/**
+ * @file    test_traj.c
+ * @brief   S 曲线轨迹发生器测试
+ * @author  HuiSpec
+ * @date    2025-09-01
+ * @version 1.0.0
+ *
+ * @details 在 10 Hz、100 Hz、1 kHz 下分别运行速度轨迹和位置轨迹（限幅与 encoder.h 中的
+ *          TRAJ_SPEED_* / TRAJ_POSITION_* 相同），逐拍检查：
+ *          1. 速度、加速度不超过限幅，相邻两拍加速度之差不超过 max_jerk·Ts；
+ *          2. 不越过目标（速度轨迹不超调，位置轨迹不过冲）；
+ *          3. 完成时间不超过连续时间下的最短时间加两个采样周期，也不短于最短时间；
+ *          4. 位置轨迹中途把目标改到来不及刹车的位置时，先刹停再折返，最终停在新目标上。
+ *
+ * @note    在 test 目录下运行 make test。
+ *
+ * @copyright Copyright © 2023 HuiSpec. All rights reserved.
+ */
+
+#include "test_common.h"
+#include "traj.h"
+#include <math.h>
+
+// 与 encoder.h 相同：FULL_SPEED_RPM = 1300
+#define SPEED_MAX_ACC 1300.0f
+#define SPEED_MAX_JERK 5200.0f
+#define POSITION_MAX_VEL 1950.0f
+#define POSITION_MAX_ACC 3900.0f
+#define POSITION_MAX_JERK 15600.0f
+#define LIMIT_TOLERANCE 1e-3 // 限幅检查的相对容差（浮点舍入）
+
+/* 从静止以加加速度 J、最大加速度 A 把速度变化 dv 所需的最短时间 */
+static double min_time_velocity(double dv, double A, double J)
+{
+    return dv >= A * A / J ? dv / A + A / J : 2.0 * sqrt(dv / J);
+}
+
+/* 从静止到静止移动距离 D 的最短时间 */
+static double min_time_position(double D, double V, double A, double J)
+{
+    // 加速到 vp 再对称减速走过的距离
+    double peak = V;
+    if (peak * min_time_velocity(peak, A, J) > D)
+    {
+        double lo = 0.0, hi = V;
+        for (int i = 0; i < 60; i++)
+        {
+            peak = 0.5 * (lo + hi);
+            if (peak * min_time_velocity(peak, A, J) > D)
+                hi = peak;
+            else
+                lo = peak;
+        }
+        return 2.0 * min_time_velocity(peak, A, J);
+    }
+    return 2.0 * min_time_velocity(V, A, J) + (D - peak * min_time_velocity(peak, A, J)) / V;
+}
+
+/* 一次轨迹的统计量 */
+typedef struct
+{
+    double peak_vel;  // |vel| 最大值
+    double peak_acc;  // |acc| 最大值
+    double peak_jerk; // |Δacc| / Ts 最大值
+    double overshoot; // 越过目标的最大量（朝运动方向为正）
+    double time;      // 到达目标并静止的时间（秒），超时为 -1
+} TrajStats;
+
+/* 运行轨迹直到完成（最多 timeout 秒），retarget_time >= 0 时在该时刻把目标改为 retarget */
+static void run_traj(Trajectory* traj, float target, double timeout, double retarget_time,
+                     float retarget, TrajStats* stats)
+{
+    double Ts      = traj->Ts;
+    double start   = traj->mode == TRAJ_MODE_POSITION ? traj->pos : traj->vel;
+    double prev    = traj->acc;
+    int ticks      = (int)(timeout / Ts + 0.5);
+    stats->peak_vel  = 0.0;
+    stats->peak_acc  = 0.0;
+    stats->peak_jerk = 0.0;
+    stats->overshoot = 0.0;
+    stats->time      = -1.0;
+    traj_set_target(traj, target);
+    for (int k = 1; k <= ticks; k++)
+    {
+        if (retarget_time >= 0.0 && k == (int)(retarget_time / Ts + 0.5))
+        {
+            start  = traj->mode == TRAJ_MODE_POSITION ? traj->pos : traj->vel;
+            target = retarget;
+            traj_set_target(traj, target);
+        }
+        double output    = traj_update(traj);
+        double dir       = target >= start ? 1.0 : -1.0;
+        double jerk      = fabs(traj->acc - prev) / Ts;
+        prev             = traj->acc;
+        stats->peak_vel  = fmax(stats->peak_vel, fabs(traj->vel));
+        stats->peak_acc  = fmax(stats->peak_acc, fabs(traj->acc));
+        stats->peak_jerk = fmax(stats->peak_jerk, jerk);
+        stats->overshoot = fmax(stats->overshoot, dir * (output - target));
+        if (traj_done(traj))
+        {
+            stats->time = k * Ts;
+            return;
+        }
+    }
+}
+
+/* 检查一次轨迹：限幅、超调和完成时间 */
+static void check_traj(const char* name, const TrajStats* stats, double max_vel, double max_acc,
+                       double max_jerk, double overshoot_max, double min_time, double Ts)
+{
+    char label[80];
+    snprintf(label, sizeof(label), "%s peak vel", name);
+    test_range(label, stats->peak_vel, 0.0, max_vel * (1.0 + LIMIT_TOLERANCE));
+    snprintf(label, sizeof(label), "%s peak acc", name);
+    test_range(label, stats->peak_acc, 0.0, max_acc * (1.0 + LIMIT_TOLERANCE));
+    snprintf(label, sizeof(label), "%s peak jerk", name);
+    test_range(label, stats->peak_jerk, 0.0, max_jerk * (1.0 + LIMIT_TOLERANCE));
+    snprintf(label, sizeof(label), "%s overshoot", name);
+    test_range(label, stats->overshoot, 0.0, overshoot_max);
+    snprintf(label, sizeof(label), "%s time (s)", name);
+    test_range(label, stats->time, min_time - Ts, min_time + 2.0 * Ts);
+}
+
+static void test_velocity(float Ts, const char* rate)
+{
+    static const float from[] = {0.0f, 0.0f, 800.0f};
+    static const float to[]   = {1300.0f, 200.0f, -800.0f};
+    for (unsigned i = 0; i < sizeof(from) / sizeof(from[0]); i++)
+    {
+        Trajectory traj;
+        TrajStats stats;
+        char name[64];
+        traj_init(&traj, TRAJ_MODE_VELOCITY, 1300.0f, SPEED_MAX_ACC, SPEED_MAX_JERK, Ts);
+        traj_reset(&traj, 0.0f, from[i]);
+        run_traj(&traj, to[i], 10.0, -1.0, 0.0f, &stats);
+        double dv = fabs(to[i] - from[i]);
+        snprintf(name, sizeof(name), "%s vel %g -> %g", rate, from[i], to[i]);
+        // 速度轨迹的限幅只有加速度和加加速度，速度不超过起点和目标中较大的一个
+        check_traj(name, &stats, fmax(fabs(from[i]), fabs(to[i])), SPEED_MAX_ACC, SPEED_MAX_JERK,
+                   1e-3 * dv, min_time_velocity(dv, SPEED_MAX_ACC, SPEED_MAX_JERK), Ts);
+        snprintf(name, sizeof(name), "%s vel %g -> %g lands exactly", rate, from[i], to[i]);
+        test_check(name, traj.vel == to[i] && traj.acc == 0.0f);
+    }
+}
+
+static void test_position(float Ts, const char* rate)
+{
+    static const float to[] = {360.0f, 5.0f, -720.0f};
+    for (unsigned i = 0; i < sizeof(to) / sizeof(to[0]); i++)
+    {
+        Trajectory traj;
+        TrajStats stats;
+        char name[64];
+        traj_init(&traj, TRAJ_MODE_POSITION, POSITION_MAX_VEL, POSITION_MAX_ACC,
+                  POSITION_MAX_JERK, Ts);
+        traj_reset(&traj, 0.0f, 0.0f);
+        run_traj(&traj, to[i], 10.0, -1.0, 0.0f, &stats);
+        snprintf(name, sizeof(name), "%s pos 0 -> %g", rate, to[i]);
+        check_traj(name, &stats, POSITION_MAX_VEL, POSITION_MAX_ACC, POSITION_MAX_JERK,
+                   1e-4 * fabs(to[i]),
+                   min_time_position(fabs(to[i]), POSITION_MAX_VEL, POSITION_MAX_ACC,
+                                     POSITION_MAX_JERK),
+                   Ts);
+        snprintf(name, sizeof(name), "%s pos 0 -> %g lands exactly", rate, to[i]);
+        test_check(name, traj.pos == to[i] && traj.vel == 0.0f && traj.acc == 0.0f);
+    }
+}
+
+/* 位置轨迹以最大速度运行时把目标改到刹车距离以内：刹停、折返，停在新目标上 */
+static void test_position_retarget(float Ts, const char* rate)
+{
+    Trajectory traj;
+    TrajStats stats;
+    char name[64];
+    traj_init(&traj, TRAJ_MODE_POSITION, POSITION_MAX_VEL, POSITION_MAX_ACC, POSITION_MAX_JERK,
+              Ts);
+    traj_reset(&traj, 0.0f, 0.0f);
+    // 0.5 秒时已接近最大速度、位置约 500 度，刹车距离约 700 度
+    run_traj(&traj, 3600.0f, 10.0, 0.5, 600.0f, &stats);
+    snprintf(name, sizeof(name), "%s pos retarget peak vel", rate);
+    test_range(name, stats.peak_vel, 0.0, POSITION_MAX_VEL * (1.0 + LIMIT_TOLERANCE));
+    snprintf(name, sizeof(name), "%s pos retarget peak acc", rate);
+    test_range(name, stats.peak_acc, 0.0, POSITION_MAX_ACC * (1.0 + LIMIT_TOLERANCE));
+    snprintf(name, sizeof(name), "%s pos retarget peak jerk", rate);
+    test_range(name, stats.peak_jerk, 0.0, POSITION_MAX_JERK * (1.0 + LIMIT_TOLERANCE));
+    snprintf(name, sizeof(name), "%s pos retarget time (s)", rate);
+    test_range(name, stats.time, 0.5, 3.0);
+    snprintf(name, sizeof(name), "%s pos retarget lands exactly", rate);
+    test_check(name, traj.pos == 600.0f && traj.vel == 0.0f);
+}
+
+int main(void)
+{
+    static const float periods[] = {0.1f, 0.01f, 0.001f};
+    static const char* const rates[] = {"10 Hz", "100 Hz", "1 kHz"};
+    for (unsigned i = 0; i < sizeof(periods) / sizeof(periods[0]); i++)
+    {
+        test_velocity(periods[i], rates[i]);
+        test_position(periods[i], rates[i]);
+        test_position_retarget(periods[i], rates[i]);
+    }
+    return test_summary("test_traj");
+}